@@ -0,0 +1,120 @@
+#include "batch.h"
+#include "compiled.h"
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+
+static unsigned threadCount(unsigned threads, size_t jobs)
+{
+    if(threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    if(threads == 0) {
+        threads = 1;
+    }
+    return (unsigned) std::min<size_t>(threads, std::max<size_t>(jobs, 1));
+}
+
+std::vector<bool> evalBatch(const std::vector<Formula> & formulas, const Structure & st, unsigned threads)
+{
+    std::vector<char> results(formulas.size(), 0);
+    std::atomic<size_t> next(0);
+
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    /* Svaka nit uzima sledecu neobradjenu formulu. Izuzetak (npr. simbol
+    bez interpretacije) se pamti i ponovo baca posle zavrsetka svih niti,
+    kao kod sekvencijalne interpretacije */
+    auto worker = [&]() {
+        try {
+            size_t i;
+            while((i = next++) < formulas.size()) {
+                CompiledFormula c(formulas[i], st);
+                results[i] = c.eval();
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            next = formulas.size();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    unsigned n = threadCount(threads, formulas.size());
+    for(unsigned i = 1; i < n; i++) {
+        pool.push_back(std::thread(worker));
+    }
+    worker();
+    for(std::thread & t : pool) {
+        t.join();
+    }
+    if(error) {
+        std::rethrow_exception(error);
+    }
+
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+bool evalParallel(const Formula & f, const Structure & st, unsigned threads)
+{
+    if(f->getType() != BaseFormula::T_FORALL && f->getType() != BaseFormula::T_EXISTS) {
+        CompiledFormula c(f, st);
+        return c.eval();
+    }
+
+    Quantifier * q = (Quantifier *) f.get();
+    bool forall = f->getType() == BaseFormula::T_FORALL;
+    const Domain & d = st.getDomain();
+
+    /* Za (forall x) trazimo element za koji podformula nije tacna, a za
+    (exists x) element za koji jeste; cim ga neka nit nadje, ostale staju */
+    std::atomic<bool> found(false);
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    unsigned n = threadCount(threads, d.size());
+    size_t chunk = (d.size() + n - 1) / n;
+
+    auto worker = [&](size_t begin, size_t end) {
+        try {
+            CompiledFormula c(q->getOperand(), st);
+            bool bound = q->getOperand()->containsVariable(q->getVariable(), true);
+            unsigned slot = bound ? c.slot(q->getVariable()) : 0;
+
+            for(size_t i = begin; i < end && !found; i++) {
+                if(bound) {
+                    c.setSlot(slot, d[i]);
+                }
+                if(c.eval() != forall) {
+                    found = true;
+                }
+                if(!bound) {
+                    break;
+                }
+            }
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            found = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(unsigned i = 1; i < n; i++) {
+        size_t begin = std::min(d.size(), i * chunk);
+        size_t end = std::min(d.size(), (i + 1) * chunk);
+        pool.push_back(std::thread(worker, begin, end));
+    }
+    worker(0, std::min(d.size(), chunk));
+    for(std::thread & t : pool) {
+        t.join();
+    }
+    if(error) {
+        std::rethrow_exception(error);
+    }
+
+    return forall ? !found : (bool) found;
+}
@@ -0,0 +1,19 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+
+#include "first_order_logic.h"
+
+/* Istovremena provera vise zatvorenih formula u istoj L-strukturi. Niti
+   dele strukturu (domen i interpretacije) samo za citanje, a svaka nit
+   prevodi formule koje proverava (videti CompiledFormula). Interpretacije
+   u strukturi zato ne smeju imati promenljivo stanje. Ako je threads
+   jednako 0, koristi se broj niti koje racunar podrzava. */
+std::vector<bool> evalBatch(const std::vector<Formula> & formulas, const Structure & st, unsigned threads = 0);
+
+/* Interpretacija jedne zatvorene formule, pri cemu se domen spoljasnjeg
+   kvantifikatora deli na delove koje obradjuju razlicite niti */
+bool evalParallel(const Formula & f, const Structure & st, unsigned threads = 0);
+
+#endif
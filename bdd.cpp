@@ -0,0 +1,151 @@
+#include "bdd.h"
+
+#include <climits>
+#include <algorithm>
+
+static uint64_t pairKey(Bdd f, Bdd g)
+{
+    return (uint64_t)f << 32 | g;
+}
+
+BddManager::BddManager()
+{
+    /* List "tacno" ima varijablu iza svih ostalih */
+    m_nodes.push_back(Node{ UINT_MAX, BDD_TRUE, BDD_TRUE });
+}
+
+unsigned BddManager::var(Bdd f) const
+{
+    return m_nodes[f >> 1].var;
+}
+
+Bdd BddManager::low(Bdd f) const
+{
+    return m_nodes[f >> 1].low ^ (f & 1);
+}
+
+Bdd BddManager::high(Bdd f) const
+{
+    return m_nodes[f >> 1].high ^ (f & 1);
+}
+
+Bdd BddManager::node(unsigned var, Bdd low, Bdd high)
+{
+    if (low == high) {
+        return low;
+    }
+
+    /* Komplement se sa visoke grane prenosi na granu ka cvoru */
+    if (high & 1) {
+        return negate(node(var, negate(low), negate(high)));
+    }
+
+    Node n{ var, low, high };
+    auto it = m_unique.find(n);
+    if (it != m_unique.end()) {
+        return it->second;
+    }
+
+    Bdd f = m_nodes.size() << 1;
+    m_nodes.push_back(n);
+    m_unique.insert(std::make_pair(n, f));
+    return f;
+}
+
+Bdd BddManager::variable(unsigned var)
+{
+    return node(var, BDD_FALSE, BDD_TRUE);
+}
+
+Bdd BddManager::conjoin(Bdd f, Bdd g)
+{
+    if (f == BDD_FALSE || g == BDD_FALSE || f == negate(g)) {
+        return BDD_FALSE;
+    }
+    if (f == BDD_TRUE || f == g) {
+        return g;
+    }
+    if (g == BDD_TRUE) {
+        return f;
+    }
+
+    if (f > g) {
+        std::swap(f, g);
+    }
+    uint64_t key = pairKey(f, g);
+    auto it = m_computed.find(key);
+    if (it != m_computed.end()) {
+        return it->second;
+    }
+
+    unsigned v = std::min(var(f), var(g));
+    Bdd f0 = var(f) == v ? low(f) : f;
+    Bdd f1 = var(f) == v ? high(f) : f;
+    Bdd g0 = var(g) == v ? low(g) : g;
+    Bdd g1 = var(g) == v ? high(g) : g;
+
+    Bdd r0 = conjoin(f0, g0);
+    Bdd r1 = conjoin(f1, g1);
+    Bdd res = node(v, r0, r1);
+
+    m_computed.insert(std::make_pair(key, res));
+    return res;
+}
+
+Bdd BddManager::disjoin(Bdd f, Bdd g)
+{
+    return negate(conjoin(negate(f), negate(g)));
+}
+
+void BddManager::cubes(Bdd f, Clause &cube, std::vector<Clause> &res) const
+{
+    if (f == BDD_FALSE) {
+        return;
+    }
+    if (f == BDD_TRUE) {
+        res.push_back(cube);
+        return;
+    }
+
+    Lit l = var(f) + 1;
+    cube.push_back(-l);
+    cubes(low(f), cube, res);
+    cube.back() = l;
+    cubes(high(f), cube, res);
+    cube.pop_back();
+}
+
+std::vector<Clause> BddManager::cubes(Bdd f) const
+{
+    std::vector<Clause> res;
+    Clause cube;
+    cubes(f, cube, res);
+    return res;
+}
+
+size_t BddManager::size() const
+{
+    return m_nodes.size();
+}
+
+Bdd formulaToBdd(const Formula &f, AtomTable &table, BddManager &manager)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+        return BDD_TRUE;
+    case BaseFormula::T_FALSE:
+        return BDD_FALSE;
+    case BaseFormula::T_ATOM:
+        return manager.variable(table.intern(f));
+    case BaseFormula::T_NOT:
+        return manager.negate(formulaToBdd(((Not*)f.get())->getOperand(), table, manager));
+    case BaseFormula::T_AND:
+        return manager.conjoin(formulaToBdd(((And*)f.get())->getOperand1(), table, manager),
+                               formulaToBdd(((And*)f.get())->getOperand2(), table, manager));
+    case BaseFormula::T_OR:
+        return manager.disjoin(formulaToBdd(((Or*)f.get())->getOperand1(), table, manager),
+                               formulaToBdd(((Or*)f.get())->getOperand2(), table, manager));
+    default:
+        throw "Bad type";
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef BDD_H
+#define BDD_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "ground.h"
+
+/* Grana BDD-a: redni broj cvora pomeren za jedan bit, a najnizi bit
+   oznacava komplement (negaciju funkcije na koju grana pokazuje) */
+typedef unsigned Bdd;
+
+const Bdd BDD_TRUE = 0;
+const Bdd BDD_FALSE = 1;
+
+/* Redukovani uredjeni BDD sa komplementiranim granama. Jedini list je
+   "tacno" (netacno je komplementirana grana ka njemu), a visoka grana
+   cvora nikad nije komplementirana, pa je svaka funkcija predstavljena
+   jedinstveno. Cvorovi se dele preko tabele jedinstvenosti, a rezultati
+   konjunkcije se pamte. Varijable su redni brojevi atoma iz tabele atoma,
+   pa atom upisan ranije stoji blize korenu */
+class BddManager {
+    struct Node {
+        unsigned var;
+        Bdd low;
+        Bdd high;
+
+        bool operator==(const Node &n) const { return var == n.var && low == n.low && high == n.high; }
+    };
+    struct NodeHash {
+        size_t operator()(const Node &n) const { return ((size_t)n.var * 1000003 + n.low) * 1000003 + n.high; }
+    };
+    std::vector<Node> m_nodes;
+    std::unordered_map<Node, Bdd, NodeHash> m_unique;
+    std::unordered_map<uint64_t, Bdd> m_computed;
+
+    unsigned var(Bdd f) const;
+    Bdd low(Bdd f) const;
+    Bdd high(Bdd f) const;
+    Bdd node(unsigned var, Bdd low, Bdd high);
+    void cubes(Bdd f, Clause &cube, std::vector<Clause> &res) const;
+
+public:
+    BddManager();
+
+    /* Funkcija jednaka varijabli */
+    Bdd variable(unsigned var);
+
+    Bdd negate(Bdd f) const { return f ^ 1; }
+    Bdd conjoin(Bdd f, Bdd g);
+    Bdd disjoin(Bdd f, Bdd g);
+
+    /* Putevi do lista "tacno", kao konjunkcije literala (disjunktan pokrivac
+    skupa modela) */
+    std::vector<Clause> cubes(Bdd f) const;
+
+    /* Broj cvorova u tabeli */
+    size_t size() const;
+};
+
+/* BDD osnovne formule u NNF-u, nad tabelom atoma */
+Bdd formulaToBdd(const Formula &f, AtomTable &table, BddManager &manager);
+
+#endif
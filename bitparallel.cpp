@@ -0,0 +1,312 @@
+#include "bitparallel.h"
+#include "compiled.h"
+
+/* Najveca dozvoljena velicina tablice (u recima) */
+static const size_t MAX_TABLE_WORDS = (size_t)1 << 27;
+
+TruthTable::TruthTable(const vector<Variable> & v, unsigned n)
+    : vars(v), domainSize(n), rows(1)
+{
+    for(unsigned i = 1; i < vars.size(); i++) {
+        rows *= n;
+        if(rows > MAX_TABLE_WORDS) {
+            throw "Truth table too large";
+        }
+    }
+
+    unsigned width = vars.empty() ? 1 : n;
+    words = (width + 63) / 64;
+
+    if(rows * words > MAX_TABLE_WORDS) {
+        throw "Truth table too large";
+    }
+    bits.assign(rows * words, 0);
+}
+
+/* Pozicija bita za date indekse: red i kolona */
+static void position(const TruthTable & t, const vector<unsigned> & indices, size_t & row, unsigned & col)
+{
+    row = 0;
+    for(unsigned i = 0; i + 1 < indices.size(); i++) {
+        row = row * t.domainSize + indices[i];
+    }
+    col = indices.empty() ? 0 : indices.back();
+}
+
+bool TruthTable::get(const vector<unsigned> & indices) const
+{
+    size_t row;
+    unsigned col;
+    position(*this, indices, row, col);
+    return (bits[row * words + col / 64] >> (col % 64)) & 1;
+}
+
+void TruthTable::set(const vector<unsigned> & indices, bool value)
+{
+    size_t row;
+    unsigned col;
+    position(*this, indices, row, col);
+    uint64_t mask = (uint64_t)1 << (col % 64);
+    if(value) {
+        bits[row * words + col / 64] |= mask;
+    } else {
+        bits[row * words + col / 64] &= ~mask;
+    }
+}
+
+/* Maska vazecih bitova poslednje reci u redu */
+static uint64_t lastWordMask(const TruthTable & t)
+{
+    unsigned width = t.vars.empty() ? 1 : t.domainSize;
+    unsigned rest = width % 64;
+    return rest == 0 ? ~(uint64_t)0 : (((uint64_t)1 << rest) - 1);
+}
+
+/* Brise bitove van domena u poslednjoj reci svakog reda */
+static void clearPadding(TruthTable & t)
+{
+    uint64_t mask = lastWordMask(t);
+    for(size_t r = 0; r < t.rows; r++) {
+        t.bits[r * t.words + t.words - 1] &= mask;
+    }
+}
+
+/* Prelazak na sledecu n-torku indeksa (leksikografski), vraca false
+   kada su sve n-torke obidjene */
+static bool nextTuple(vector<unsigned> & tuple, unsigned n)
+{
+    for(size_t i = tuple.size(); i > 0; i--) {
+        if(++tuple[i - 1] < n) {
+            return true;
+        }
+        tuple[i - 1] = 0;
+    }
+    return false;
+}
+
+/* Prosiruje tablicu na nove varijable (nadskup starih, u zadatom redosledu),
+   pri cemu vrednost ne zavisi od dodatih varijabli */
+static TruthTable expand(const TruthTable & t, const vector<Variable> & vars)
+{
+    if(t.vars == vars) {
+        return t;
+    }
+
+    TruthTable res(vars, t.domainSize);
+
+    /* Pozicije starih varijabli u novom redosledu */
+    vector<unsigned> pos;
+    for(const Variable & v : t.vars) {
+        pos.push_back(find(vars.begin(), vars.end(), v) - vars.begin());
+    }
+
+    if(!t.vars.empty() && t.vars.back() == vars.back()) {
+        /* Poslednja varijabla je ista, pa se kopiraju celi redovi */
+        vector<unsigned> prefix(vars.size() - 1, 0);
+        size_t row = 0;
+        do {
+            size_t src = 0;
+            for(unsigned i = 0; i + 1 < pos.size(); i++) {
+                src = src * t.domainSize + prefix[pos[i]];
+            }
+            copy(t.bits.begin() + src * t.words, t.bits.begin() + (src + 1) * t.words,
+                 res.bits.begin() + row * res.words);
+            row++;
+        } while(nextTuple(prefix, t.domainSize));
+        return res;
+    }
+
+    vector<unsigned> tuple(vars.size(), 0);
+    vector<unsigned> old(t.vars.size());
+    do {
+        for(unsigned i = 0; i < pos.size(); i++) {
+            old[i] = tuple[pos[i]];
+        }
+        if(t.get(old)) {
+            res.set(tuple, true);
+        }
+    } while(nextTuple(tuple, t.domainSize));
+    return res;
+}
+
+/* Unija varijabli dve tablice, u leksikografskom redosledu */
+static vector<Variable> mergeVars(const vector<Variable> & a, const vector<Variable> & b)
+{
+    VariableSet all(a.begin(), a.end());
+    all.insert(b.begin(), b.end());
+    return vector<Variable>(all.begin(), all.end());
+}
+
+static TruthTable combine(const TruthTable & a, const TruthTable & b, BaseFormula::Type type)
+{
+    vector<Variable> vars = mergeVars(a.vars, b.vars);
+    TruthTable res = expand(a, vars);
+    TruthTable eb = expand(b, vars);
+
+    uint64_t * r = res.bits.data();
+    const uint64_t * y = eb.bits.data();
+    size_t count = res.bits.size();
+
+    switch(type) {
+    case BaseFormula::T_AND:
+        for(size_t i = 0; i < count; i++) r[i] &= y[i];
+        break;
+    case BaseFormula::T_OR:
+        for(size_t i = 0; i < count; i++) r[i] |= y[i];
+        break;
+    case BaseFormula::T_IMP:
+        for(size_t i = 0; i < count; i++) r[i] = ~r[i] | y[i];
+        break;
+    case BaseFormula::T_IFF:
+        for(size_t i = 0; i < count; i++) r[i] = ~(r[i] ^ y[i]);
+        break;
+    default:
+        throw "Bad type";
+    }
+
+    clearPadding(res);
+    return res;
+}
+
+static TruthTable quantify(const TruthTable & t, const Variable & v, bool forall)
+{
+    vector<Variable>::const_iterator it = find(t.vars.begin(), t.vars.end(), v);
+    if(it == t.vars.end()) {
+        /* Domen je neprazan, pa je kvantifikator nepotreban */
+        return t;
+    }
+
+    size_t p = it - t.vars.begin();
+    vector<Variable> vars = t.vars;
+    vars.erase(vars.begin() + p);
+    TruthTable res(vars, t.domainSize);
+    unsigned n = t.domainSize;
+
+    if(p + 1 == t.vars.size()) {
+        /* Kvantifikuje se poslednja varijabla: svaki red se svodi na jedan bit */
+        uint64_t mask = lastWordMask(t);
+        vector<unsigned> tuple(vars.size(), 0);
+        for(size_t r = 0; r < t.rows; r++) {
+            const uint64_t * row = t.bits.data() + r * t.words;
+            bool value = forall;
+            for(size_t w = 0; w < t.words; w++) {
+                uint64_t full = w + 1 == t.words ? mask : ~(uint64_t)0;
+                if(forall && row[w] != full) {
+                    value = false;
+                    break;
+                } else if(!forall && row[w] != 0) {
+                    value = true;
+                    break;
+                }
+            }
+            if(value) {
+                res.set(tuple, true);
+            }
+            nextTuple(tuple, n);
+        }
+        return res;
+    }
+
+    /* Redovi tablice su rasporedjeni kao (prefiks, x, sufiks), pa je red
+    rezultata (prefiks, sufiks) AND/OR n redova polazne tablice */
+    size_t suffix = 1;
+    for(size_t i = p + 1; i + 1 < t.vars.size(); i++) {
+        suffix *= n;
+    }
+    size_t prefix = t.rows / (suffix * n);
+    size_t words = t.words;
+
+    if(forall) {
+        fill(res.bits.begin(), res.bits.end(), ~(uint64_t)0);
+    }
+
+    for(size_t a = 0; a < prefix; a++) {
+        for(unsigned x = 0; x < n; x++) {
+            const uint64_t * src = t.bits.data() + ((a * n + x) * suffix) * words;
+            uint64_t * dst = res.bits.data() + (a * suffix) * words;
+            size_t count = suffix * words;
+            if(forall) {
+                for(size_t i = 0; i < count; i++) dst[i] &= src[i];
+            } else {
+                for(size_t i = 0; i < count; i++) dst[i] |= src[i];
+            }
+        }
+    }
+
+    clearPadding(res);
+    return res;
+}
+
+static TruthTable evalAtom(const Formula & f, const Structure & st)
+{
+    VariableSet free;
+    f->getVars(free, true);
+    vector<Variable> vars(free.begin(), free.end());
+
+    const Domain & d = st.getDomain();
+    TruthTable res(vars, d.size());
+    CompiledFormula atom(f, st);
+
+    vector<unsigned> tuple(vars.size(), 0);
+    do {
+        for(unsigned i = 0; i < tuple.size(); i++) {
+            atom.setSlot(i, d[tuple[i]]);
+        }
+        if(atom.eval()) {
+            res.set(tuple, true);
+        }
+    } while(nextTuple(tuple, d.size()));
+    return res;
+}
+
+TruthTable evalTable(const Formula & f, const Structure & st)
+{
+    unsigned n = st.getDomain().size();
+
+    switch(f->getType()) {
+    case BaseFormula::T_TRUE: {
+        TruthTable res(vector<Variable>(), n);
+        res.bits[0] = 1;
+        return res;
+    }
+    case BaseFormula::T_FALSE:
+        return TruthTable(vector<Variable>(), n);
+    case BaseFormula::T_ATOM:
+        return evalAtom(f, st);
+    case BaseFormula::T_NOT: {
+        TruthTable res = evalTable(((Not *) f.get())->getOperand(), st);
+        for(size_t i = 0; i < res.bits.size(); i++) {
+            res.bits[i] = ~res.bits[i];
+        }
+        clearPadding(res);
+        return res;
+    }
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF: {
+        BinaryConnective * bc = (BinaryConnective *) f.get();
+        return combine(evalTable(bc->getOperand1(), st), evalTable(bc->getOperand2(), st), f->getType());
+    }
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS: {
+        Quantifier * q = (Quantifier *) f.get();
+        return quantify(evalTable(q->getOperand(), st), q->getVariable(),
+                        f->getType() == BaseFormula::T_FORALL);
+    }
+    }
+    throw "Bad type";
+}
+
+bool evalBitParallel(const Formula & f, const Structure & st, const Valuation & val)
+{
+    TruthTable t = evalTable(f, st);
+    const Domain & d = st.getDomain();
+
+    vector<unsigned> indices;
+    for(const Variable & v : t.vars) {
+        unsigned value = val.getValue(v);
+        indices.push_back(find(d.begin(), d.end(), value) - d.begin());
+    }
+    return t.get(indices);
+}
@@ -0,0 +1,35 @@
+#ifndef BITPARALLEL_H
+#define BITPARALLEL_H
+
+#include <vector>
+#include <cstdint>
+
+#include "first_order_logic.h"
+
+/* Tablica istinitosnih vrednosti formule po svim n-torkama (indeksa u
+   domenu) njenih slobodnih varijabli x1,...,xk. Tablica je podeljena u
+   n^(k-1) redova po n bitova (za poslednju varijablu), a svaki red je
+   poravnat na 64-bitne reci, pa se logicki veznici i kvantifikatori
+   izracunavaju operacijama nad celim recima */
+struct TruthTable {
+    vector<Variable> vars;
+    unsigned domainSize;
+    size_t rows;
+    size_t words;
+    vector<uint64_t> bits;
+
+    TruthTable(const vector<Variable> & vars, unsigned domainSize);
+
+    bool get(const vector<unsigned> & indices) const;
+    void set(const vector<unsigned> & indices, bool value);
+};
+
+/* Izracunava tablicu formule u datoj strukturi. Kvantifikator po varijabli
+   x se svodi na AND/OR redova tablice podformule duz dimenzije x */
+TruthTable evalTable(const Formula & f, const Structure & st);
+
+/* Interpretacija formule u datoj strukturi i valuaciji, izracunata preko
+   tablice istinitosnih vrednosti */
+bool evalBitParallel(const Formula & f, const Structure & st, const Valuation & val);
+
+#endif
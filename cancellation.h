@@ -0,0 +1,58 @@
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+
+/* Zahtev za prekid dokazivanja koji se moze postaviti iz druge niti.
+   Dokazivaci ga proveravaju na mestima gde je prekid bezbedan (izmedju
+   nivoa Erbranovog univerzuma, izabranih klauza, koraka pretrage) i tada
+   vracaju PR_UNKNOWN. Token moze imati roditelja, ciji prekid prekida i
+   njega (npr. niti koje pobijaju komponente unutar niti portfolija) */
+class CancellationToken {
+    std::atomic<bool> m_cancelled;
+    const CancellationToken *m_parent;
+public:
+    CancellationToken(const CancellationToken *parent = nullptr) : m_cancelled(false), m_parent(parent) {}
+
+    void cancel() { m_cancelled = true; }
+    bool cancelled() const { return m_cancelled || (m_parent && m_parent->cancelled()); }
+};
+
+/* Izuzetak kojim throwIfCancelled prekida dokazivanje iz dubine poziva;
+   hvataju ga prove i gilmore i tada vracaju PR_UNKNOWN */
+struct ProofCancelled {};
+
+/* Token tekuce niti. Postavlja ga CancellationScope, pa funkcije koje ne
+   primaju ProverOptions (prelazak na sledeci nivo Erbranovog univerzuma,
+   generisanje n-torki, supstitucija, multiplikacija) mogu proveriti
+   prekid bez prenosenja tokena */
+inline const CancellationToken *&currentCancellation()
+{
+    static thread_local const CancellationToken *token = nullptr;
+    return token;
+}
+
+/* Postavlja token tekuce niti dok traje doseg, pa vraca prethodni */
+class CancellationScope {
+    const CancellationToken *m_previous;
+public:
+    CancellationScope(const CancellationToken *token) : m_previous(currentCancellation())
+    {
+        currentCancellation() = token;
+    }
+    ~CancellationScope() { currentCancellation() = m_previous; }
+
+    CancellationScope(const CancellationScope &) = delete;
+    CancellationScope &operator=(const CancellationScope &) = delete;
+};
+
+/* Baca ProofCancelled ako je token tekuce niti prekinut */
+inline void throwIfCancelled()
+{
+    const CancellationToken *token = currentCancellation();
+    if (token && token->cancelled()) {
+        throw ProofCancelled();
+    }
+}
+
+#endif
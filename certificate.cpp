@@ -0,0 +1,216 @@
+#include "certificate.h"
+#include "serialize.h"
+#include "ground.h"
+
+#include <cstdlib>
+
+/* Gradi zatvoren tablo pretragom u dubinu. U svakom cvoru se grana po
+   instanci koja ima najmanje konjunkcija koje se ne zatvaraju odmah (kao
+   kod propagacije jedinicnih klauza), a instance koje grana vec
+   zadovoljava se preskacu, jer grananje po njima ne moze zatvoriti granu */
+class TableauBuilder {
+    struct Conjunct {
+        Clause literals;
+        bool closed;
+    };
+
+    std::vector< std::vector<Conjunct> > m_dnf;
+    std::vector<bool> m_used;
+    std::vector<Lit> m_branch;
+    std::vector<int> m_position;
+    std::vector<uint32_t> &m_tableau;
+
+    static size_t slot(Lit l) { return 2 * (std::abs(l) - 1) + (l < 0); }
+
+    bool closes(const Conjunct &c) const;
+    bool satisfied(const Conjunct &c) const;
+    void extend(const Clause &literals, std::vector<size_t> &marked);
+    void retract(size_t size, const std::vector<size_t> &marked);
+
+public:
+    TableauBuilder(const std::vector<Formula> &instances, std::vector<uint32_t> &tableau);
+
+    bool build();
+};
+
+TableauBuilder::TableauBuilder(const std::vector<Formula> &instances, std::vector<uint32_t> &tableau)
+    : m_used(instances.size(), false), m_tableau(tableau)
+{
+    AtomTable atoms;
+    for (const Formula &f : instances) {
+        m_dnf.push_back(std::vector<Conjunct>());
+        for (const LiteralList &l : f->listDNF()) {
+            Conjunct c;
+            c.literals = encodeLiterals(l, atoms);
+            c.closed = false;
+            for (Lit a : c.literals) {
+                for (Lit b : c.literals) {
+                    c.closed = c.closed || a == -b;
+                }
+            }
+            m_dnf.back().push_back(c);
+        }
+    }
+    m_position.assign(2 * atoms.size(), -1);
+}
+
+bool TableauBuilder::closes(const Conjunct &c) const
+{
+    if (c.closed) {
+        return true;
+    }
+    for (Lit l : c.literals) {
+        if (m_position[slot(-l)] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TableauBuilder::satisfied(const Conjunct &c) const
+{
+    for (Lit l : c.literals) {
+        if (m_position[slot(l)] < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TableauBuilder::extend(const Clause &literals, std::vector<size_t> &marked)
+{
+    for (Lit l : literals) {
+        if (m_position[slot(l)] < 0) {
+            m_position[slot(l)] = m_branch.size();
+            marked.push_back(slot(l));
+        }
+        m_branch.push_back(l);
+    }
+}
+
+void TableauBuilder::retract(size_t size, const std::vector<size_t> &marked)
+{
+    for (size_t s : marked) {
+        m_position[s] = -1;
+    }
+    m_branch.resize(size);
+}
+
+bool TableauBuilder::build()
+{
+    throwIfCancelled();
+
+    size_t best = m_dnf.size();
+    size_t bestOpen = 0;
+    for (size_t i = 0; i < m_dnf.size() && !(best < m_dnf.size() && bestOpen == 0); ++i) {
+        if (m_used[i]) {
+            continue;
+        }
+
+        size_t open = 0;
+        bool sat = false;
+        for (const Conjunct &c : m_dnf[i]) {
+            if (closes(c)) {
+                continue;
+            }
+            if (satisfied(c)) {
+                sat = true;
+                break;
+            }
+            ++open;
+        }
+
+        if (!sat && (best == m_dnf.size() || open < bestOpen)) {
+            best = i;
+            bestOpen = open;
+        }
+    }
+
+    /* Grana zadovoljava sve instance */
+    if (best == m_dnf.size()) {
+        return false;
+    }
+
+    m_used[best] = true;
+    m_tableau.push_back(TS_BRANCH);
+    m_tableau.push_back(best);
+
+    for (const Conjunct &c : m_dnf[best]) {
+        size_t size = m_branch.size();
+        std::vector<size_t> marked;
+        extend(c.literals, marked);
+
+        bool closed = false;
+        for (size_t q = size; q < m_branch.size() && !closed; ++q) {
+            int p = m_position[slot(-m_branch[q])];
+            if (p >= 0) {
+                m_tableau.push_back(TS_CLOSE);
+                m_tableau.push_back(p);
+                m_tableau.push_back(q);
+                closed = true;
+            }
+        }
+
+        bool ok = closed || build();
+        retract(size, marked);
+        if (!ok) {
+            m_used[best] = false;
+            return false;
+        }
+    }
+
+    m_used[best] = false;
+    return true;
+}
+
+bool closeTableau(Certificate &c)
+{
+    c.tableau.clear();
+    TableauBuilder builder(c.instances, c.tableau);
+    return builder.build();
+}
+
+void saveCertificate(const std::string &path, const Signature &s, const Certificate &c)
+{
+    BinaryWriter w(SK_CERTIFICATE);
+
+    w.signature(s);
+    w.formula(c.formula);
+    w.number(c.miniscope);
+    w.number(c.clausal);
+    w.formula(c.matrix);
+    w.number(c.instances.size());
+    for (size_t i = 0; i < c.instances.size(); ++i) {
+        w.number(c.conjuncts[i]);
+        w.formula(c.instances[i]);
+    }
+    w.number(c.tableau.size());
+    for (uint32_t n : c.tableau) {
+        w.number(n);
+    }
+
+    w.save(path);
+}
+
+void loadCertificate(const std::string &path, Signature &s, Certificate &c)
+{
+    BinaryReader r(path, SK_CERTIFICATE, s);
+    r.signature(s);
+
+    c = Certificate();
+    c.formula = r.formula();
+    c.miniscope = r.number();
+    c.clausal = r.number();
+    c.matrix = r.formula();
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.conjuncts.push_back(r.number());
+        c.instances.push_back(r.formula());
+    }
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.tableau.push_back(r.number());
+    }
+
+    if (!r.atEnd()) {
+        throw "Bad certificate";
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef CERTIFICATE_H
+#define CERTIFICATE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "first_order_logic.h"
+
+/* Oznaka instance cele matrice (a ne jednog njenog konjunkta) */
+const uint32_t WHOLE_MATRIX = 0xFFFFFFFF;
+
+/* Vrsta cvora tabloa u zapisu sertifikata */
+enum TableauStep { TS_CLOSE = 0, TS_BRANCH = 1 };
+
+/* Sertifikat nezadovoljivosti formule:
+   - formula koja se pobija (negirana teorema) i nacin pripreme (miniscope,
+     clausal), iz kojih provera ponovo izvodi skolemizovanu matricu i
+     poredi je sa zapisanom, do na preimenovanje varijabli i novih
+     (Skolemovih i definicionih) simbola,
+   - skolemizovana matrica,
+   - osnovne instance matrice, uz redni broj konjunkta matrice (na najvisem
+     nivou, s leva na desno) cija je instanca, odnosno WHOLE_MATRIX,
+   - zatvoren tablo nad instancama, zapisan kao niz reci u preorder
+     obilasku. Cvor TS_BRANCH i grana tablo po konjunkcijama DNF-a
+     (listDNF) instance i, redom, i za svaku konjunkciju sledi podstablo;
+     grana je niz literala izabranih konjunkcija. Cvor TS_CLOSE p q
+     zatvara granu: literali na pozicijama p i q grane su komplementarni.
+   Provera tabloa ne zahteva pretragu, pa je linearna u velicini tabloa (i
+   DNF-ova instanci na koje se tablo poziva) */
+struct Certificate {
+    Formula formula;
+    bool miniscope = false;
+    bool clausal = false;
+    Formula matrix;
+    std::vector<Formula> instances;
+    std::vector<uint32_t> conjuncts;
+    std::vector<uint32_t> tableau;
+};
+
+/* Gradi zatvoren tablo nad instancama sertifikata. Vraca false ako tablo
+   ne postoji, tj. ako su instance (iskazno) zadovoljive */
+bool closeTableau(Certificate &c);
+
+/* Zapisuje signaturu i sertifikat u binarnu datoteku (format iz
+   serialize.h) */
+void saveCertificate(const std::string &path, const Signature &s, const Certificate &c);
+
+/* Cita sertifikat; simboli se dodaju u signaturu s */
+void loadCertificate(const std::string &path, Signature &s, Certificate &c);
+
+#endif
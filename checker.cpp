@@ -0,0 +1,410 @@
+#include "first_order_logic.h"
+#include "certificate.h"
+#include "serialize.h"
+
+#include <iostream>
+#include <map>
+#include <set>
+
+/* Obostrano jednoznacno preslikavanje imena (varijabli ili simbola) */
+class Renaming {
+    std::map<std::string, std::string> m_forward;
+    std::map<std::string, std::string> m_backward;
+public:
+    bool add(const std::string &a, const std::string &b)
+    {
+        auto f = m_forward.insert(std::make_pair(a, b));
+        auto b2 = m_backward.insert(std::make_pair(b, a));
+        return f.first->second == b && b2.first->second == a;
+    }
+
+    const std::map<std::string, std::string> &pairs() const { return m_forward; }
+};
+
+/* Nezavisna provera sertifikata koji zapisuje Gilmorova procedura (videti
+   certificate.h). Iz zapisane formule se ponovo izvodi matrica i poredi sa
+   zapisanom, proverava se da je svaka instanca zaista instanca (konjunkta)
+   matrice, i da je tablo nad instancama zatvoren. Koristi se samo logika
+   prvog reda i citanje binarnog zapisa, a ne kod dokazivaca */
+class CertificateChecker {
+    Signature &m_signature;
+    const Certificate &m_certificate;
+    std::vector<Formula> m_parts;
+    std::vector<LiteralListList> m_dnf;
+    std::vector<bool> m_expanded;
+    LiteralList m_branch;
+    size_t m_pos;
+
+    typedef std::map<Variable, Term> Match;
+
+    static bool matchTerm(const Term &p, const Term &t, Match &m);
+    static bool matchFormula(const Formula &p, const Formula &f, Match &m);
+    static bool complementary(const Formula &l1, const Formula &l2);
+
+    /* Imena novih simbola (Skolemovih i definicionih) i varijabli zavise od
+    brojaca dokazivaca, pa se izvedena i zapisana matrica porede do na
+    preimenovanje */
+    Renaming m_variables, m_functions, m_predicates;
+    std::set<std::string> m_fixed;
+
+    Formula deriveMatrix();
+    void collectSymbols(const Term &t);
+    void collectSymbols(const Formula &f);
+    bool sameTerm(const Term &t1, const Term &t2);
+    bool sameFormula(const Formula &f1, const Formula &f2);
+    void checkMatrix();
+
+    uint32_t next();
+    void checkInstance(size_t i) const;
+    void checkNode();
+
+public:
+    CertificateChecker(Signature &s, const Certificate &c);
+
+    /* Baca izuzetak (nisku) ako sertifikat nije ispravan */
+    void check();
+};
+
+CertificateChecker::CertificateChecker(Signature &s, const Certificate &c)
+    : m_signature(s), m_certificate(c), m_dnf(c.instances.size()), m_expanded(c.instances.size(), false), m_pos(0)
+{
+    /* Konjunkti matrice, istim redom kao u instantiationUnits */
+    std::vector<Formula> stack{c.matrix};
+    while (!stack.empty()) {
+        Formula f = stack.back();
+        stack.pop_back();
+        if (f->getType() == BaseFormula::T_AND) {
+            stack.push_back(((And*)f.get())->getOperand2());
+            stack.push_back(((And*)f.get())->getOperand1());
+        } else {
+            m_parts.push_back(f);
+        }
+    }
+}
+
+bool CertificateChecker::matchTerm(const Term &p, const Term &t, Match &m)
+{
+    if (p->getType() == BaseTerm::TT_VARIABLE) {
+        const Variable &v = ((VariableTerm*)p.get())->getVariable();
+        auto it = m.find(v);
+        if (it == m.end()) {
+            m[v] = t;
+            return true;
+        }
+        return it->second->equalTo(t);
+    }
+
+    if (t->getType() != BaseTerm::TT_FUNCTION) {
+        return false;
+    }
+    FunctionTerm *pf = (FunctionTerm*)p.get();
+    FunctionTerm *tf = (FunctionTerm*)t.get();
+    if (pf->getSymbol() != tf->getSymbol() || pf->getOperands().size() != tf->getOperands().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < pf->getOperands().size(); ++i) {
+        if (!matchTerm(pf->getOperands()[i], tf->getOperands()[i], m)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CertificateChecker::matchFormula(const Formula &p, const Formula &f, Match &m)
+{
+    if (p->getType() != f->getType()) {
+        return false;
+    }
+
+    switch (p->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        return true;
+    case BaseFormula::T_ATOM: {
+        Atom *pa = (Atom*)p.get();
+        Atom *fa = (Atom*)f.get();
+        if (pa->getSymbol() != fa->getSymbol() || pa->getOperands().size() != fa->getOperands().size()) {
+            return false;
+        }
+        for (size_t i = 0; i < pa->getOperands().size(); ++i) {
+            if (!matchTerm(pa->getOperands()[i], fa->getOperands()[i], m)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case BaseFormula::T_NOT:
+        return matchFormula(((Not*)p.get())->getOperand(), ((Not*)f.get())->getOperand(), m);
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF: {
+        BinaryConnective *pb = (BinaryConnective*)p.get();
+        BinaryConnective *fb = (BinaryConnective*)f.get();
+        return matchFormula(pb->getOperand1(), fb->getOperand1(), m) &&
+               matchFormula(pb->getOperand2(), fb->getOperand2(), m);
+    }
+    default:
+        /* Matrica je bez kvantifikatora */
+        return false;
+    }
+}
+
+bool CertificateChecker::complementary(const Formula &l1, const Formula &l2)
+{
+    return (l1->getType() == BaseFormula::T_NOT && ((Not*)l1.get())->getOperand()->equalTo(l2)) ||
+           (l2->getType() == BaseFormula::T_NOT && ((Not*)l2.get())->getOperand()->equalTo(l1));
+}
+
+/* Priprema formule kao u skolemMatrix (i clausesToFormula uz clausal) */
+Formula CertificateChecker::deriveMatrix()
+{
+    const Formula &f = m_certificate.formula;
+    Formula matrix = m_certificate.miniscope ? removeUniversalQ(f->nnf()->miniscope()->skolem(m_signature)->prenex())
+                                             : removeUniversalQ(f->nnf()->prenex()->skolem(m_signature));
+    if (!m_certificate.clausal) {
+        return matrix;
+    }
+
+    Formula res;
+    for (const LiteralList &clause : matrix->definitionalCNF(m_signature)) {
+        Formula c;
+        if (clause.empty()) {
+            c = std::make_shared<False>();
+        } else {
+            c = clause[0];
+            for (size_t i = 1; i < clause.size(); ++i) {
+                c = std::make_shared<Or>(c, clause[i]);
+            }
+        }
+        res = res ? std::make_shared<And>(res, c) : c;
+    }
+    return res ? res : std::make_shared<True>();
+}
+
+void CertificateChecker::collectSymbols(const Term &t)
+{
+    if (t->getType() == BaseTerm::TT_FUNCTION) {
+        m_fixed.insert(((FunctionTerm*)t.get())->getSymbol());
+        for (const Term &op : ((FunctionTerm*)t.get())->getOperands()) {
+            collectSymbols(op);
+        }
+    }
+}
+
+void CertificateChecker::collectSymbols(const Formula &f)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_ATOM:
+        m_fixed.insert(((Atom*)f.get())->getSymbol());
+        for (const Term &op : ((Atom*)f.get())->getOperands()) {
+            collectSymbols(op);
+        }
+        break;
+    case BaseFormula::T_NOT:
+        collectSymbols(((Not*)f.get())->getOperand());
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+        collectSymbols(((BinaryConnective*)f.get())->getOperand1());
+        collectSymbols(((BinaryConnective*)f.get())->getOperand2());
+        break;
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS:
+        collectSymbols(((Quantifier*)f.get())->getOperand());
+        break;
+    default:
+        break;
+    }
+}
+
+bool CertificateChecker::sameTerm(const Term &t1, const Term &t2)
+{
+    if (t1->getType() != t2->getType()) {
+        return false;
+    }
+    if (t1->getType() == BaseTerm::TT_VARIABLE) {
+        return m_variables.add(((VariableTerm*)t1.get())->getVariable(), ((VariableTerm*)t2.get())->getVariable());
+    }
+
+    FunctionTerm *f1 = (FunctionTerm*)t1.get();
+    FunctionTerm *f2 = (FunctionTerm*)t2.get();
+    if (f1->getOperands().size() != f2->getOperands().size() || !m_functions.add(f1->getSymbol(), f2->getSymbol())) {
+        return false;
+    }
+    for (size_t i = 0; i < f1->getOperands().size(); ++i) {
+        if (!sameTerm(f1->getOperands()[i], f2->getOperands()[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CertificateChecker::sameFormula(const Formula &f1, const Formula &f2)
+{
+    if (f1->getType() != f2->getType()) {
+        return false;
+    }
+
+    switch (f1->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        return true;
+    case BaseFormula::T_ATOM: {
+        Atom *a1 = (Atom*)f1.get();
+        Atom *a2 = (Atom*)f2.get();
+        if (a1->getOperands().size() != a2->getOperands().size() || !m_predicates.add(a1->getSymbol(), a2->getSymbol())) {
+            return false;
+        }
+        for (size_t i = 0; i < a1->getOperands().size(); ++i) {
+            if (!sameTerm(a1->getOperands()[i], a2->getOperands()[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case BaseFormula::T_NOT:
+        return sameFormula(((Not*)f1.get())->getOperand(), ((Not*)f2.get())->getOperand());
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF: {
+        BinaryConnective *b1 = (BinaryConnective*)f1.get();
+        BinaryConnective *b2 = (BinaryConnective*)f2.get();
+        return sameFormula(b1->getOperand1(), b2->getOperand1()) && sameFormula(b1->getOperand2(), b2->getOperand2());
+    }
+    default:
+        /* Matrica je bez kvantifikatora */
+        return false;
+    }
+}
+
+/* Zapisana matrica mora biti izvedena matrica sa preimenovanim
+   varijablama i novim simbolima; simboli polazne formule se ne menjaju, a
+   novi simboli ne smeju postati simboli polazne formule */
+void CertificateChecker::checkMatrix()
+{
+    collectSymbols(m_certificate.formula);
+
+    if (!sameFormula(deriveMatrix(), m_certificate.matrix)) {
+        throw "Matrix is not derived from the formula";
+    }
+    for (const Renaming *r : { &m_functions, &m_predicates }) {
+        for (const auto &p : r->pairs()) {
+            bool fixed = m_fixed.find(p.first) != m_fixed.end();
+            if (fixed ? p.first != p.second : m_fixed.find(p.second) != m_fixed.end()) {
+                throw "Matrix is not derived from the formula";
+            }
+        }
+    }
+}
+
+uint32_t CertificateChecker::next()
+{
+    if (m_pos >= m_certificate.tableau.size()) {
+        throw "Tableau is truncated";
+    }
+    return m_certificate.tableau[m_pos++];
+}
+
+void CertificateChecker::checkInstance(size_t i) const
+{
+    uint32_t part = m_certificate.conjuncts[i];
+    Formula pattern;
+    if (part == WHOLE_MATRIX) {
+        pattern = m_certificate.matrix;
+    } else if (part < m_parts.size()) {
+        pattern = m_parts[part];
+    } else {
+        throw "Bad conjunct index";
+    }
+
+    Match m;
+    if (!matchFormula(pattern, m_certificate.instances[i], m)) {
+        throw "Instance is not an instance of the matrix";
+    }
+}
+
+void CertificateChecker::checkNode()
+{
+    uint32_t step = next();
+
+    if (step == TS_CLOSE) {
+        uint32_t p = next();
+        uint32_t q = next();
+        if (p >= m_branch.size() || q >= m_branch.size() || !complementary(m_branch[p], m_branch[q])) {
+            throw "Branch is not closed";
+        }
+        return;
+    }
+    if (step != TS_BRANCH) {
+        throw "Bad tableau step";
+    }
+
+    uint32_t i = next();
+    if (i >= m_certificate.instances.size()) {
+        throw "Bad instance index";
+    }
+    if (!m_expanded[i]) {
+        m_dnf[i] = m_certificate.instances[i]->listDNF();
+        m_expanded[i] = true;
+    }
+
+    for (const LiteralList &conjunct : m_dnf[i]) {
+        size_t size = m_branch.size();
+        m_branch.insert(m_branch.end(), conjunct.begin(), conjunct.end());
+        checkNode();
+        m_branch.resize(size);
+    }
+}
+
+void CertificateChecker::check()
+{
+    checkMatrix();
+
+    for (size_t i = 0; i < m_certificate.instances.size(); ++i) {
+        checkInstance(i);
+    }
+
+    checkNode();
+    if (m_pos != m_certificate.tableau.size()) {
+        throw "Trailing tableau steps";
+    }
+}
+
+/* Uz sertifikat se moze zadati i datoteka sa teoremom (u formatu
+   saveFormula); tada se proverava i da je pobijena formula njena negacija */
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3) {
+        std::cout << "Usage: " << argv[0] << " <certificate> [conjecture]" << std::endl;
+        return 2;
+    }
+
+    try {
+        Signature s;
+        Certificate c;
+        loadCertificate(argv[1], s, c);
+
+        if (argc == 3) {
+            Signature sc;
+            Formula conjecture = loadFormula(argv[2], sc);
+            if (!c.formula->equalTo(std::make_shared<Not>(conjecture))) {
+                throw "Certificate is not for the given conjecture";
+            }
+        }
+
+        CertificateChecker checker(s, c);
+        checker.check();
+
+        std::cout << "VALID: " << c.instances.size() << " instances, "
+                  << c.tableau.size() << " tableau words" << std::endl;
+        std::cout << "Unsatisfiable formula: " << c.formula << std::endl;
+    } catch (const char *msg) {
+        std::cout << "INVALID: " << msg << std::endl;
+        return 1;
+    }
+    return 0;
+}
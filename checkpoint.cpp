@@ -0,0 +1,83 @@
+#include "checkpoint.h"
+#include "serialize.h"
+
+#include <fstream>
+#include <cstdio>
+
+void saveCheckpoint(const std::string &path, const Signature &s, const Checkpoint &c)
+{
+    BinaryWriter w(SK_CHECKPOINT);
+
+    w.signature(s);
+    w.formula(c.formula);
+    w.number(c.miniscope);
+    w.number(c.clausal);
+    w.formula(c.matrix);
+    w.number(c.iteration);
+    w.number(c.level.size());
+    for (const Term &t : c.level) {
+        w.term(t);
+    }
+    w.number(c.atoms.size());
+    for (const Formula &a : c.atoms) {
+        w.formula(a);
+    }
+
+    w.number(c.instances.size());
+    for (const Formula &f : c.instances) {
+        w.formula(f);
+    }
+    w.number(c.processed);
+    w.number(c.conjuncts.size());
+    for (const Clause &conjunct : c.conjuncts) {
+        w.literals(conjunct);
+    }
+
+    std::string tmp = path + ".tmp";
+    try {
+        w.save(tmp);
+    } catch (...) {
+        std::remove(tmp.c_str());
+        throw;
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw "Cannot write checkpoint";
+    }
+}
+
+bool loadCheckpoint(const std::string &path, Signature &s, Checkpoint &c)
+{
+    if (!std::ifstream(path)) {
+        return false;
+    }
+
+    BinaryReader r(path, SK_CHECKPOINT, s);
+    r.signature(s);
+
+    c = Checkpoint();
+    c.formula = r.formula();
+    c.miniscope = r.number();
+    c.clausal = r.number();
+    c.matrix = r.formula();
+    c.iteration = r.number();
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.level.insert(r.term());
+    }
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.atoms.push_back(r.formula());
+    }
+
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.instances.push_back(r.formula());
+    }
+    c.processed = r.number();
+    for (uint32_t i = r.number(); i > 0; --i) {
+        c.conjuncts.push_back(r.literals());
+    }
+
+    if (!r.atEnd()) {
+        throw "Bad checkpoint";
+    }
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <set>
+
+#include "first_order_logic.h"
+#include "ground.h"
+
+/* Stanje Gilmorove procedure iz kog se dokazivanje moze nastaviti:
+   formula koja se pobija i nacin pripreme (miniscope, clausal), po kojima
+   se prepoznaje kontrolna tacka druge formule, skolemizovana matrica,
+   redni broj iteracije i tekuci nivo Erbranovog univerzuma, kao i tabela
+   osnovnih atoma. Ako je kontrolna tacka zapisana usred nivoa (metodom
+   multiplikacije), cuvaju se i instance tog nivoa, broj vec pomnozenih
+   instanci i preostale (otvorene) konjunkcije */
+struct Checkpoint {
+    Formula formula;
+    bool miniscope = false;
+    bool clausal = false;
+    Formula matrix;
+    size_t iteration = 0;
+    std::set<Term> level;
+    std::vector<Formula> atoms;
+
+    std::vector<Formula> instances;
+    size_t processed = 0;
+    std::vector<Clause> conjuncts;
+};
+
+/* Zapisuje signaturu i stanje u binarnu datoteku (format iz
+   serialize.h, pa se zajednicki podtermovi instanci i atoma zapisuju samo
+   jednom). Datoteka se najpre
+   zapisuje pod privremenim imenom, pa preimenuje, tako da prekid tokom
+   zapisivanja ne unisti prethodnu kontrolnu tacku */
+void saveCheckpoint(const std::string &path, const Signature &s, const Checkpoint &c);
+
+/* Cita kontrolnu tacku: simboli se dodaju u signaturu s, a termovi i
+   formule stanja se vezuju za nju. Vraca false ako datoteka ne postoji */
+bool loadCheckpoint(const std::string &path, Signature &s, Checkpoint &c);
+
+#endif
@@ -0,0 +1,361 @@
+#include "compiled.h"
+
+CompiledFormula::CompiledFormula(const Formula & f, const Structure & st)
+    : _st(st), _clock(0)
+{
+    VariableSet free;
+    f->getVars(free, true);
+
+    map<Variable, unsigned> scope;
+    for(const Variable & v : free) {
+        scope[v] = _free.size();
+        _free.push_back(v);
+    }
+    _slots.resize(_free.size(), st.getDomain().empty() ? 0 : st.getDomain()[0]);
+
+    _root = compileFormula(f, scope);
+    _slotStamps.assign(_slots.size(), 0);
+}
+
+void CompiledFormula::writeSlot(unsigned slot, unsigned value)
+{
+    _slots[slot] = value;
+    _slotStamps[slot] = ++_clock;
+}
+
+CompiledFormula::Op CompiledFormula::tableOp(bool table, size_t arity)
+{
+    if(!table || arity > 3) {
+        return OP_GENERIC;
+    }
+    static const Op ops[] = { OP_TABLE0, OP_TABLE1, OP_TABLE2, OP_TABLE3 };
+    return ops[arity];
+}
+
+unsigned CompiledFormula::compileTerm(const Term & t, map<Variable, unsigned> & scope)
+{
+    TermNode node;
+    node.op = OP_VARIABLE;
+    node.slot = 0;
+    node.fun = NULL;
+    node.table = NULL;
+    node.firstOp = 0;
+    node.numOps = 0;
+    node.buffer = 0;
+    node.memo = false;
+    node.firstDep = 0;
+    node.numDeps = 0;
+    node.valid = false;
+    node.cached = 0;
+    node.stamp = 0;
+
+    /* Kljuc cvora za spajanje jednakih podtermova */
+    string key;
+    vector<unsigned> ops;
+
+    if(t->getType() == BaseTerm::TT_VARIABLE) {
+        node.slot = scope.at(((VariableTerm *) t.get())->getVariable());
+        key = "$" + to_string(node.slot);
+    } else {
+        FunctionTerm * ft = (FunctionTerm *) t.get();
+        key = ft->getSymbol() + "(";
+        for(const Term & op : ft->getOperands()) {
+            ops.push_back(compileTerm(op, scope));
+            key += to_string(ops.back()) + ",";
+        }
+        key += ")";
+    }
+
+    map<string, unsigned>::iterator it = _termIds.find(key);
+    if(it != _termIds.end()) {
+        return it->second;
+    }
+
+    if(t->getType() == BaseTerm::TT_FUNCTION) {
+        FunctionTerm * ft = (FunctionTerm *) t.get();
+        node.fun = _st.getFunction(ft->getSymbol());
+        node.table = dynamic_cast<TableFunction *>(node.fun);
+        node.op = tableOp(node.table != NULL, ops.size());
+
+        node.firstOp = _termOps.size();
+        node.numOps = ops.size();
+        _termOps.insert(_termOps.end(), ops.begin(), ops.end());
+
+        node.buffer = _buffers.size();
+        _buffers.push_back(vector<unsigned>(ops.size()));
+
+        /* Slotovi od kojih term zavisi; pamte se samo vrednosti termova
+        koji sadrze druge slozene termove */
+        set<unsigned> deps;
+        for(unsigned op : ops) {
+            const TermNode & child = _terms[op];
+            if(child.op == OP_VARIABLE) {
+                deps.insert(child.slot);
+            } else {
+                node.memo = true;
+                deps.insert(_termDeps.begin() + child.firstDep,
+                            _termDeps.begin() + child.firstDep + child.numDeps);
+            }
+        }
+        node.firstDep = _termDeps.size();
+        node.numDeps = deps.size();
+        _termDeps.insert(_termDeps.end(), deps.begin(), deps.end());
+    }
+
+    _terms.push_back(node);
+    _termIds.insert(make_pair(key, _terms.size() - 1));
+    return _terms.size() - 1;
+}
+
+unsigned CompiledFormula::compileFormula(const Formula & f, map<Variable, unsigned> & scope)
+{
+    Node node;
+    node.type = f->getType();
+    node.op1 = node.op2 = 0;
+    node.slot = 0;
+    node.op = OP_GENERIC;
+    node.rel = NULL;
+    node.table = NULL;
+    node.firstOp = 0;
+    node.numOps = 0;
+    node.buffer = 0;
+
+    switch(f->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        break;
+    case BaseFormula::T_ATOM: {
+        Atom * a = (Atom *) f.get();
+        node.rel = _st.getRelation(a->getSymbol());
+        node.table = dynamic_cast<TableRelation *>(node.rel);
+        node.op = tableOp(node.table != NULL, a->getOperands().size());
+
+        vector<unsigned> ops;
+        for(const Term & op : a->getOperands()) {
+            ops.push_back(compileTerm(op, scope));
+        }
+
+        node.firstOp = _termOps.size();
+        node.numOps = ops.size();
+        _termOps.insert(_termOps.end(), ops.begin(), ops.end());
+
+        node.buffer = _buffers.size();
+        _buffers.push_back(vector<unsigned>(ops.size()));
+        break;
+    }
+    case BaseFormula::T_NOT:
+        node.op1 = compileFormula(((Not *) f.get())->getOperand(), scope);
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+        node.op1 = compileFormula(((BinaryConnective *) f.get())->getOperand1(), scope);
+        node.op2 = compileFormula(((BinaryConnective *) f.get())->getOperand2(), scope);
+        break;
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS: {
+        /* Svaki kvantifikator dobija svoj slot, pa se vezana varijabla koja
+        zaklanja istoimenu spoljasnju varijablu ne mesa sa njom */
+        Quantifier * q = (Quantifier *) f.get();
+        node.slot = _slots.size();
+        _slots.push_back(0);
+
+        map<Variable, unsigned>::iterator it = scope.find(q->getVariable());
+        bool shadowed = it != scope.end();
+        unsigned old = shadowed ? it->second : 0;
+
+        scope[q->getVariable()] = node.slot;
+        node.op1 = compileFormula(q->getOperand(), scope);
+
+        if(shadowed) {
+            scope[q->getVariable()] = old;
+        } else {
+            scope.erase(q->getVariable());
+        }
+        break;
+    }
+    }
+
+    _nodes.push_back(node);
+    return _nodes.size() - 1;
+}
+
+unsigned CompiledFormula::evalTerm(unsigned t)
+{
+    TermNode & node = _terms[t];
+    if(node.op == OP_VARIABLE) {
+        return _slots[node.slot];
+    }
+
+    if(node.memo && node.valid) {
+        bool valid = true;
+        for(unsigned i = 0; i < node.numDeps; i++) {
+            if(_slotStamps[_termDeps[node.firstDep + i]] > node.stamp) {
+                valid = false;
+                break;
+            }
+        }
+        if(valid) {
+            return node.cached;
+        }
+    }
+
+    unsigned value = computeTerm(node);
+    if(node.memo) {
+        node.cached = value;
+        node.stamp = _clock;
+        node.valid = true;
+    }
+    return value;
+}
+
+unsigned CompiledFormula::computeTerm(const TermNode & node)
+{
+    const unsigned * ops = _termOps.data() + node.firstOp;
+    unsigned args[3];
+
+    switch(node.op) {
+    case OP_TABLE0:
+        return node.table->lookup<0>(args);
+    case OP_TABLE1:
+        args[0] = evalTerm(ops[0]);
+        return node.table->lookup<1>(args);
+    case OP_TABLE2:
+        args[0] = evalTerm(ops[0]);
+        args[1] = evalTerm(ops[1]);
+        return node.table->lookup<2>(args);
+    case OP_TABLE3:
+        args[0] = evalTerm(ops[0]);
+        args[1] = evalTerm(ops[1]);
+        args[2] = evalTerm(ops[2]);
+        return node.table->lookup<3>(args);
+    default:
+        break;
+    }
+
+    vector<unsigned> & buffer = _buffers[node.buffer];
+    for(unsigned i = 0; i < node.numOps; i++) {
+        buffer[i] = evalTerm(ops[i]);
+    }
+    return node.fun->eval(buffer);
+}
+
+bool CompiledFormula::evalAtom(const Node & node)
+{
+    const unsigned * ops = _termOps.data() + node.firstOp;
+    unsigned args[3];
+
+    switch(node.op) {
+    case OP_TABLE0:
+        return node.table->lookup<0>(args);
+    case OP_TABLE1:
+        args[0] = evalTerm(ops[0]);
+        return node.table->lookup<1>(args);
+    case OP_TABLE2:
+        args[0] = evalTerm(ops[0]);
+        args[1] = evalTerm(ops[1]);
+        return node.table->lookup<2>(args);
+    case OP_TABLE3:
+        args[0] = evalTerm(ops[0]);
+        args[1] = evalTerm(ops[1]);
+        args[2] = evalTerm(ops[2]);
+        return node.table->lookup<3>(args);
+    default:
+        break;
+    }
+
+    vector<unsigned> & buffer = _buffers[node.buffer];
+    for(unsigned i = 0; i < node.numOps; i++) {
+        buffer[i] = evalTerm(ops[i]);
+    }
+    return node.rel->eval(buffer);
+}
+
+bool CompiledFormula::evalNode(unsigned n)
+{
+    const Node & node = _nodes[n];
+
+    switch(node.type) {
+    case BaseFormula::T_TRUE:
+        return true;
+    case BaseFormula::T_FALSE:
+        return false;
+    case BaseFormula::T_ATOM:
+        return evalAtom(node);
+    case BaseFormula::T_NOT:
+        return !evalNode(node.op1);
+    case BaseFormula::T_AND:
+        return evalNode(node.op1) && evalNode(node.op2);
+    case BaseFormula::T_OR:
+        return evalNode(node.op1) || evalNode(node.op2);
+    case BaseFormula::T_IMP:
+        return !evalNode(node.op1) || evalNode(node.op2);
+    case BaseFormula::T_IFF:
+        return evalNode(node.op1) == evalNode(node.op2);
+    case BaseFormula::T_FORALL: {
+        const Domain & d = _st.getDomain();
+        for(unsigned i = 0; i < d.size(); i++) {
+            writeSlot(node.slot, d[i]);
+            if(!evalNode(node.op1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    case BaseFormula::T_EXISTS: {
+        const Domain & d = _st.getDomain();
+        for(unsigned i = 0; i < d.size(); i++) {
+            writeSlot(node.slot, d[i]);
+            if(evalNode(node.op1)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    }
+    return false;
+}
+
+const vector<Variable> & CompiledFormula::freeVariables() const
+{
+    return _free;
+}
+
+unsigned CompiledFormula::slot(const Variable & v) const
+{
+    for(unsigned i = 0; i < _free.size(); i++) {
+        if(_free[i] == v) {
+            return i;
+        }
+    }
+    throw "Variable unknown!";
+}
+
+void CompiledFormula::setSlot(unsigned slot, unsigned value)
+{
+    writeSlot(slot, value);
+}
+
+void CompiledFormula::setValue(const Variable & v, unsigned value)
+{
+    writeSlot(slot(v), value);
+}
+
+bool CompiledFormula::eval()
+{
+    return evalNode(_root);
+}
+
+bool CompiledFormula::eval(const Valuation & val)
+{
+    for(unsigned i = 0; i < _free.size(); i++) {
+        writeSlot(i, val.getValue(_free[i]));
+    }
+    return evalNode(_root);
+}
+
+const Structure & CompiledFormula::getStructure() const
+{
+    return _st;
+}
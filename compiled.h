@@ -0,0 +1,102 @@
+#ifndef COMPILED_H
+#define COMPILED_H
+
+#include <vector>
+
+#include "first_order_logic.h"
+
+/* Formula prevedena za brzu evaluaciju u datoj L-strukturi. Stablo formule
+   se pretvara u niz cvorova, varijable dobijaju mesta (slotove) u nizu
+   vrednosti umesto mape, a funkcije i relacije se odredjuju jednom, pri
+   prevodjenju. Tokom evaluacije se ne alocira memorija: svaki cvor ima
+   unapred alociran niz za argumente. Za simbole interpretirane tablicama
+   (TableFunction, TableRelation, videti Structure::tabulate) arnosti do 3
+   se pri prevodjenju bira posebna operacija koja tablicu cita direktno,
+   bez virtuelnog poziva.
+
+   Jednaki podtermovi (npr. Skolemovi termovi koji se ponavljaju) se pri
+   prevodjenju spajaju u jedan cvor. Vrednost slozenog terma se pamti i
+   ponovo koristi dok se ne promeni neka od varijabli od kojih term zavisi:
+   svaki upis u slot dobija novu vremensku oznaku, a zapamcena vrednost
+   vazi ako je izracunata posle poslednjeg upisa u slotove terma. */
+class CompiledFormula {
+public:
+    CompiledFormula(const Formula & f, const Structure & st);
+
+    /* Slobodne varijable formule (njihovi slotovi su 0,...,n-1) */
+    const vector<Variable> & freeVariables() const;
+
+    /* Slot slobodne varijable */
+    unsigned slot(const Variable & v) const;
+
+    /* Postavljanje vrednosti slota */
+    void setSlot(unsigned slot, unsigned value);
+
+    /* Postavljanje vrednosti slobodne varijable */
+    void setValue(const Variable & v, unsigned value);
+
+    /* Evaluacija sa trenutnim vrednostima slobodnih varijabli */
+    bool eval();
+
+    /* Evaluacija u kojoj se vrednosti slobodnih varijabli citaju iz val */
+    bool eval(const Valuation & val);
+
+    const Structure & getStructure() const;
+
+private:
+    /* Nacin izracunavanja cvora: varijabla, opsta funkcija (relacija) ili
+    tablica poznate arnosti */
+    enum Op { OP_VARIABLE, OP_GENERIC, OP_TABLE0, OP_TABLE1, OP_TABLE2, OP_TABLE3 };
+
+    struct TermNode {
+        Op op;
+        unsigned slot;
+        Function * fun;
+        TableFunction * table;
+        unsigned firstOp;
+        unsigned numOps;
+        unsigned buffer;
+        bool memo;
+        unsigned firstDep;
+        unsigned numDeps;
+        bool valid;
+        unsigned cached;
+        unsigned long stamp;
+    };
+
+    struct Node {
+        BaseFormula::Type type;
+        unsigned op1, op2;
+        unsigned slot;
+        Op op;
+        Relation * rel;
+        TableRelation * table;
+        unsigned firstOp;
+        unsigned numOps;
+        unsigned buffer;
+    };
+
+    const Structure & _st;
+    vector<Variable> _free;
+    vector<TermNode> _terms;
+    vector<unsigned> _termOps;
+    vector<Node> _nodes;
+    vector<vector<unsigned> > _buffers;
+    vector<unsigned> _slots;
+    vector<unsigned long> _slotStamps;
+    unsigned long _clock;
+    map<string, unsigned> _termIds;
+    vector<unsigned> _termDeps;
+    unsigned _root;
+
+    unsigned compileTerm(const Term & t, map<Variable, unsigned> & scope);
+    unsigned compileFormula(const Formula & f, map<Variable, unsigned> & scope);
+    static Op tableOp(bool table, size_t arity);
+    void writeSlot(unsigned slot, unsigned value);
+    unsigned evalTerm(unsigned t);
+    unsigned computeTerm(const TermNode & node);
+    bool evalAtom(const Node & node);
+    bool evalNode(unsigned n);
+};
+
+#endif
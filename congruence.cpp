@@ -0,0 +1,193 @@
+#include "congruence.h"
+
+/* Predikatski simboli se razlikuju od funkcijskih istog imena */
+static const std::string PREDICATE_PREFIX = "@";
+
+CongruenceClosure::CongruenceClosure()
+{
+    m_true = node("@true", std::vector<unsigned>());
+    m_false = node("@false", std::vector<unsigned>());
+}
+
+unsigned CongruenceClosure::find(unsigned n) const
+{
+    while (m_parent[n] != n) {
+        n = m_parent[n];
+    }
+    return n;
+}
+
+CongruenceClosure::Key CongruenceClosure::signature(unsigned n) const
+{
+    Key key(m_symbols[n], std::vector<unsigned>());
+    for (unsigned a : m_args[n]) {
+        key.second.push_back(find(a));
+    }
+    return key;
+}
+
+unsigned CongruenceClosure::node(const std::string &symbol, const std::vector<unsigned> &args)
+{
+    Key key(symbol, args);
+    auto it = m_nodes.find(key);
+    if (it != m_nodes.end()) {
+        return it->second;
+    }
+
+    unsigned n = m_symbols.size();
+    m_nodes.insert(std::make_pair(key, n));
+    m_symbols.push_back(symbol);
+    m_args.push_back(args);
+    m_parent.push_back(n);
+    m_size.push_back(1);
+    m_uses.push_back(std::vector<unsigned>());
+
+    for (unsigned a : args) {
+        m_uses[find(a)].push_back(n);
+    }
+
+    /* Novi cvor moze biti kongruentan nekom postojecem */
+    Key sig = signature(n);
+    auto s = m_signatures.find(sig);
+    if (s == m_signatures.end()) {
+        m_signatures.insert(std::make_pair(sig, n));
+    } else {
+        merge(n, s->second);
+    }
+    return n;
+}
+
+void CongruenceClosure::merge(unsigned a, unsigned b)
+{
+    std::vector< std::pair<unsigned, unsigned> > pending{ std::make_pair(a, b) };
+
+    while (!pending.empty()) {
+        unsigned x = find(pending.back().first);
+        unsigned y = find(pending.back().second);
+        pending.pop_back();
+        if (x == y) {
+            continue;
+        }
+
+        /* Manja klasa se pripaja vecoj */
+        if (m_size[x] < m_size[y]) {
+            std::swap(x, y);
+        }
+        m_parent[y] = x;
+        m_size[x] += m_size[y];
+
+        /* Termovi ciji su argumenti bili u klasi y menjaju potpis; stari
+        potpisi ostaju u tabeli, ali se vise ne mogu traziti */
+        std::vector<unsigned> uses;
+        uses.swap(m_uses[y]);
+        for (unsigned u : uses) {
+            Key sig = signature(u);
+            auto s = m_signatures.find(sig);
+            if (s == m_signatures.end()) {
+                m_signatures.insert(std::make_pair(sig, u));
+            } else if (find(s->second) != find(u)) {
+                pending.push_back(std::make_pair(u, s->second));
+            }
+            m_uses[x].push_back(u);
+        }
+    }
+}
+
+unsigned CongruenceClosure::term(const Term &t)
+{
+    if (t->getType() != BaseTerm::TT_FUNCTION) {
+        throw "Ground term expected";
+    }
+
+    FunctionTerm *ft = (FunctionTerm*)t.get();
+    std::vector<unsigned> args;
+    for (const Term &op : ft->getOperands()) {
+        args.push_back(term(op));
+    }
+    return node(ft->getSymbol(), args);
+}
+
+bool CongruenceClosure::assertLiteral(const Formula &literal)
+{
+    bool positive = true;
+    Formula atom = literal;
+    if (atom->getType() == BaseFormula::T_NOT) {
+        positive = false;
+        atom = ((Not*)atom.get())->getOperand();
+    }
+    if (atom->getType() != BaseFormula::T_ATOM) {
+        throw "Bad type";
+    }
+
+    Atom *a = (Atom*)atom.get();
+    std::vector<unsigned> args;
+    for (const Term &op : a->getOperands()) {
+        args.push_back(term(op));
+    }
+
+    if (a->getSignature().isEquality(a->getSymbol())) {
+        if (positive) {
+            merge(args[0], args[1]);
+        } else {
+            m_disequalities.push_back(std::make_pair(args[0], args[1]));
+        }
+    } else {
+        merge(node(PREDICATE_PREFIX + a->getSymbol(), args), positive ? m_true : m_false);
+    }
+
+    return consistent();
+}
+
+bool CongruenceClosure::equal(unsigned a, unsigned b) const
+{
+    return find(a) == find(b);
+}
+
+bool CongruenceClosure::consistent() const
+{
+    if (equal(m_true, m_false)) {
+        return false;
+    }
+    for (const std::pair<unsigned, unsigned> &d : m_disequalities) {
+        if (equal(d.first, d.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool consistentLiterals(const LiteralList &literals)
+{
+    CongruenceClosure cc;
+    for (const Formula &l : literals) {
+        if (!cc.assertLiteral(l)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool equalityConflict(const LiteralList &literals, LiteralList &conflict)
+{
+    /* Najkraci nesaglasan prefiks */
+    CongruenceClosure cc;
+    size_t n = 0;
+    while (n < literals.size() && cc.assertLiteral(literals[n])) {
+        ++n;
+    }
+    if (n == literals.size()) {
+        return false;
+    }
+
+    /* Poslednji literal prefiksa je sigurno u konfliktu; ostali se redom
+    izbacuju dok god preostali skup ostaje nesaglasan */
+    conflict.assign(literals.begin(), literals.begin() + n + 1);
+    for (size_t i = n; i-- > 0; ) {
+        LiteralList smaller = conflict;
+        smaller.erase(smaller.begin() + i);
+        if (!consistentLiterals(smaller)) {
+            conflict = smaller;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef CONGRUENCE_H
+#define CONGRUENCE_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "first_order_logic.h"
+
+/* Kongruentno zatvorenje nad osnovnim termovima. Termovi se dele (isti
+   term je uvek isti cvor), klase jednakosti se cuvaju strukturom
+   union-find, a tabela potpisa (simbol i predstavnici klasa argumenata)
+   otkriva kongruentne termove. Atom p(t1,...,tn) se predstavlja cvorom
+   koji se izjednacava sa cvorom "tacno" ili "netacno", pa se i p(a), ~p(b)
+   uz a = b prepoznaju kao protivrecni. Literali se dodaju inkrementalno */
+class CongruenceClosure {
+    typedef std::pair< std::string, std::vector<unsigned> > Key;
+
+    std::map<Key, unsigned> m_nodes;
+    std::map<Key, unsigned> m_signatures;
+    std::vector<std::string> m_symbols;
+    std::vector< std::vector<unsigned> > m_args;
+    std::vector<unsigned> m_parent;
+    std::vector<unsigned> m_size;
+    std::vector< std::vector<unsigned> > m_uses;
+
+    std::vector< std::pair<unsigned, unsigned> > m_disequalities;
+    unsigned m_true;
+    unsigned m_false;
+
+    unsigned find(unsigned n) const;
+    Key signature(unsigned n) const;
+    unsigned node(const std::string &symbol, const std::vector<unsigned> &args);
+    void merge(unsigned a, unsigned b);
+
+public:
+    CongruenceClosure();
+
+    /* Cvor osnovnog terma */
+    unsigned term(const Term &t);
+
+    /* Dodaje osnovni literal (jednakost, razlicitost ili atom sa znakom) i
+    vraca da li je skup dodatih literala i dalje saglasan */
+    bool assertLiteral(const Formula &literal);
+
+    bool equal(unsigned a, unsigned b) const;
+    bool consistent() const;
+};
+
+/* Da li je skup osnovnih literala saglasan sa teorijom jednakosti */
+bool consistentLiterals(const LiteralList &literals);
+
+/* Ako skup osnovnih literala nije saglasan, vraca (u conflict) njegov
+   minimalan nesaglasan podskup */
+bool equalityConflict(const LiteralList &literals, LiteralList &conflict);
+
+#endif
@@ -0,0 +1,150 @@
+#include "conjunct_store.h"
+
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Redni broj segmenta, jedinstven u procesu (i izmedju niti) */
+static std::atomic<unsigned> segmentCounter(0);
+
+ConjunctStore::ConjunctStore(size_t budget, const std::string &directory)
+    : m_budget(budget), m_directory(directory), m_count(0)
+{}
+
+ConjunctStore::~ConjunctStore()
+{
+    for (const std::string &path : m_segments) {
+        std::remove(path.c_str());
+    }
+}
+
+void ConjunctStore::spill()
+{
+    std::string path = m_directory + "/gilmore-" + std::to_string(getpid()) + "-" +
+            std::to_string(segmentCounter++) + ".seg";
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw "Cannot create segment file";
+    }
+    size_t written = std::fwrite(m_buffer.data(), sizeof(int32_t), m_buffer.size(), file);
+    if (std::fclose(file) != 0 || written != m_buffer.size()) {
+        std::remove(path.c_str());
+        throw "Cannot write segment file";
+    }
+
+    m_segments.push_back(path);
+    m_buffer.clear();
+    m_buffer.shrink_to_fit();
+}
+
+void ConjunctStore::add(const Clause &conjunct)
+{
+    m_buffer.push_back(conjunct.size());
+    m_buffer.insert(m_buffer.end(), conjunct.begin(), conjunct.end());
+    ++m_count;
+
+    if (m_buffer.size() * sizeof(int32_t) > m_budget) {
+        spill();
+    }
+}
+
+size_t ConjunctStore::size() const
+{
+    return m_count;
+}
+
+size_t ConjunctStore::segments() const
+{
+    return m_segments.size();
+}
+
+/* Prolaz kroz niz zapisa konjunkcija */
+static bool scan(const int32_t *data, size_t n, const std::function<bool(const Lit *, size_t)> &f)
+{
+    size_t i = 0;
+    while (i < n) {
+        size_t length = data[i];
+        if (!f(data + i + 1, length)) {
+            return false;
+        }
+        i += length + 1;
+    }
+    return true;
+}
+
+void ConjunctStore::forEach(const std::function<bool(const Lit *, size_t)> &f) const
+{
+    for (const std::string &path : m_segments) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw "Cannot open segment file";
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw "Cannot open segment file";
+        }
+
+        size_t bytes = st.st_size;
+        void *data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            throw "Cannot map segment file";
+        }
+        madvise(data, bytes, MADV_SEQUENTIAL);
+
+        bool more = scan((const int32_t *)data, bytes / sizeof(int32_t), f);
+        munmap(data, bytes);
+        if (!more) {
+            return;
+        }
+    }
+
+    scan(m_buffer.data(), m_buffer.size(), f);
+}
+
+/* Poredak literala: po atomu, pa pozitivan pre negativnog */
+static bool literalLess(Lit a, Lit b)
+{
+    return std::abs(a) < std::abs(b) || (std::abs(a) == std::abs(b) && a > b);
+}
+
+bool sortConjunct(Clause &conjunct)
+{
+    std::sort(conjunct.begin(), conjunct.end(), literalLess);
+    conjunct.erase(std::unique(conjunct.begin(), conjunct.end()), conjunct.end());
+    for (size_t i = 1; i < conjunct.size(); ++i) {
+        if (conjunct[i] == -conjunct[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mergeConjuncts(const Lit *a, size_t na, const Lit *b, size_t nb, Clause &res)
+{
+    res.clear();
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] == b[j]) {
+            res.push_back(a[i]);
+            ++i;
+            ++j;
+        } else if (a[i] == -b[j]) {
+            return false;
+        } else if (literalLess(a[i], b[j])) {
+            res.push_back(a[i++]);
+        } else {
+            res.push_back(b[j++]);
+        }
+    }
+    res.insert(res.end(), a + i, a + na);
+    res.insert(res.end(), b + j, b + nb);
+    return true;
+}
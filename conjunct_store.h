@@ -0,0 +1,56 @@
+#ifndef CONJUNCT_STORE_H
+#define CONJUNCT_STORE_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "ground.h"
+
+/* Skup konjunkcija osnovnih literala (celobrojni zapis, videti ground.h)
+   koji moze biti veci od radne memorije. Konjunkcije se dodaju u bafer u
+   memoriji, a kada bafer predje zadati budzet, zapisuje se na disk kao
+   segment. Zapis konjunkcije je njena duzina, pa njeni literali (32-bitni
+   celi brojevi). Konjunkcije se citaju jedino redom, prolazom kroz
+   segmente mapirane u memoriju (mmap) i kroz bafer. Datoteke segmenata se
+   brisu zajedno sa skupom */
+class ConjunctStore {
+    size_t m_budget;
+    std::string m_directory;
+    std::vector<int32_t> m_buffer;
+    std::vector<std::string> m_segments;
+    size_t m_count;
+
+    void spill();
+
+public:
+    /* budget je najveca velicina bafera u bajtovima, a directory direktorijum
+    za datoteke segmenata */
+    ConjunctStore(size_t budget, const std::string &directory);
+    ~ConjunctStore();
+
+    ConjunctStore(const ConjunctStore &) = delete;
+    ConjunctStore &operator=(const ConjunctStore &) = delete;
+
+    void add(const Clause &conjunct);
+
+    /* Broj konjunkcija */
+    size_t size() const;
+
+    /* Broj segmenata na disku */
+    size_t segments() const;
+
+    /* Poziva f za svaku konjunkciju (niz literala i njegova duzina); prolaz
+    se prekida kada f vrati false */
+    void forEach(const std::function<bool(const Lit *, size_t)> &f) const;
+};
+
+/* Unija dve konjunkcije sortirane funkcijom sortConjunct; vraca false ako
+   unija sadrzi komplementaran par */
+bool mergeConjuncts(const Lit *a, size_t na, const Lit *b, size_t nb, Clause &res);
+
+/* Sortira literale konjunkcije po atomu (pa po znaku) i izbacuje
+   ponovljene; vraca false ako konjunkcija sadrzi komplementaran par */
+bool sortConjunct(Clause &conjunct);
+
+#endif
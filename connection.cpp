@@ -0,0 +1,187 @@
+#include "connection.h"
+#include "unification.h"
+#include "ground.h"
+
+#include <functional>
+
+/* Nastavak pretrage: poziva se kada su zatvoreni svi literali tekuce
+   klauze, sa prosirenom supstitucijom i lemama */
+typedef std::function<bool(const Substitution &, const LiteralList &)> Continuation;
+
+class ConnectionProver {
+    LiteralListList m_clauses;
+    std::vector< std::pair<unsigned, unsigned> > m_refs;
+    DiscriminationTree m_index;
+
+    const ProverOptions &m_opts;
+    unsigned m_limit;
+    bool m_limitReached;
+    unsigned m_renamed;
+
+    bool sameLiteral(const Formula &l1, const Formula &l2, const Substitution &s) const;
+    bool solve(const LiteralList &clause, size_t i, const LiteralList &path, const LiteralList &lemmas,
+               const Substitution &s, const Continuation &k);
+
+public:
+    ConnectionProver(const LiteralListList &clauses, const ProverOptions &opts);
+
+    ProofResult run();
+};
+
+static Formula complement(const Formula &l)
+{
+    if (l->getType() == BaseFormula::T_NOT) {
+        return ((Not*)l.get())->getOperand();
+    }
+    return std::make_shared<Not>(l);
+}
+
+ConnectionProver::ConnectionProver(const LiteralListList &clauses, const ProverOptions &opts)
+    : m_opts(opts), m_limit(0), m_limitReached(false), m_renamed(0)
+{
+    for (const LiteralList &clause : clauses) {
+        unsigned c = m_clauses.size();
+        m_clauses.push_back(renameClause(clause, "X"));
+        for (unsigned i = 0; i < clause.size(); ++i) {
+            m_index.insert(m_clauses[c][i], m_refs.size());
+            m_refs.push_back(std::make_pair(c, i));
+        }
+    }
+}
+
+bool ConnectionProver::sameLiteral(const Formula &l1, const Formula &l2, const Substitution &s) const
+{
+    return atomKey(applySubstitution(l1, s)) == atomKey(applySubstitution(l2, s));
+}
+
+bool ConnectionProver::solve(const LiteralList &clause, size_t i, const LiteralList &path,
+                             const LiteralList &lemmas, const Substitution &s, const Continuation &k)
+{
+    if (m_opts.cancelled()) {
+        return false;
+    }
+
+    if (i == clause.size()) {
+        return k(s, lemmas);
+    }
+
+    const Formula &literal = clause[i];
+
+    /* Regularnost: literal se ne sme vec nalaziti na putu */
+    for (const Formula &p : path) {
+        if (sameLiteral(literal, p, s)) {
+            return false;
+        }
+    }
+
+    /* Lema */
+    for (const Formula &l : lemmas) {
+        if (sameLiteral(literal, l, s)) {
+            return solve(clause, i + 1, path, lemmas, s, k);
+        }
+    }
+
+    Formula comp = complement(literal);
+
+    /* Redukcija */
+    for (const Formula &p : path) {
+        Substitution r = s;
+        if (unify(comp, p, r) && solve(clause, i + 1, path, lemmas, r, k)) {
+            return true;
+        }
+    }
+
+    /* Ekstenzija */
+    if (path.size() >= m_limit) {
+        m_limitReached = true;
+        return false;
+    }
+
+    LiteralList extended = path;
+    extended.push_back(literal);
+
+    for (unsigned ref : m_index.unifiable(applySubstitution(comp, s))) {
+        const LiteralList &input = m_clauses[m_refs[ref].first];
+        unsigned j = m_refs[ref].second;
+
+        LiteralList renamed = renameClause(input, "V" + std::to_string(m_renamed++) + "_");
+        Substitution r = s;
+        if (!unify(comp, renamed[j], r)) {
+            continue;
+        }
+
+        LiteralList rest;
+        for (unsigned m = 0; m < renamed.size(); ++m) {
+            if (m != j) {
+                rest.push_back(renamed[m]);
+            }
+        }
+
+        /* Posle zatvaranja nove klauze nastavlja se sa ostatkom tekuce, a
+        dokazani literal postaje lema. Leme dokazane unutar ekstenzije se
+        ne prenose: one mogu zavisiti od literala na produzenom putu, koga
+        na kracem putu nema */
+        Continuation next = [&](const Substitution &r2, const LiteralList &) {
+            LiteralList l = lemmas;
+            l.push_back(literal);
+            return solve(clause, i + 1, path, l, r2, k);
+        };
+        if (solve(rest, 0, extended, lemmas, r, next)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ProofResult ConnectionProver::run()
+{
+    Continuation done = [](const Substitution &, const LiteralList &) { return true; };
+
+    for (m_limit = 1; m_limit <= m_opts.maxDepth; ++m_limit) {
+        m_limitReached = false;
+
+        /* Pocetne klauze su klauze bez negativnih literala: skup klauza u
+        kome ih nema je zadovoljiv (svi atomi netacni) */
+        for (const LiteralList &clause : m_clauses) {
+            bool positive = true;
+            for (const Formula &l : clause) {
+                positive = positive && l->getType() != BaseFormula::T_NOT;
+            }
+
+            if (positive && solve(clause, 0, LiteralList(), LiteralList(), Substitution(), done)) {
+                return PR_UNSAT;
+            }
+        }
+
+        if (m_opts.cancelled()) {
+            return PR_UNKNOWN;
+        }
+        if (!m_limitReached) {
+            return PR_SAT;
+        }
+    }
+
+    return PR_UNKNOWN;
+}
+
+ProofResult connection(Signature s, const Formula &f, const ProverOptions &opts)
+{
+    ConnectionProver prover(skolemMatrix(s, f, opts)->definitionalCNF(s), opts);
+
+    ProofResult res = prover.run();
+
+    /* Konekcije se traze samo sintaksno, i za atome jednakosti */
+    if (res == PR_SAT && s.hasEquality()) {
+        res = PR_UNKNOWN;
+    }
+    if (!opts.verbose) {
+        return res;
+    }
+    if (res == PR_UNSAT) {
+        std::cout << "UNSAT" << std::endl;
+    } else if (res == PR_SAT) {
+        std::cout << "SAT" << std::endl;
+    }
+    return res;
+}
@@ -0,0 +1,22 @@
+#ifndef CONNECTION_H
+#define CONNECTION_H
+
+#include "first_order_logic.h"
+#include "gilmore.h"
+
+/* Konekcioni dokazivac u stilu leanCoP-a. Formula se priprema kao kod
+   Gilmorove procedure i svodi na klauze definicionom KNF. Dokaz je tablo
+   klauza: pocinje od klauze sa samo pozitivnim literalima, a svaki literal
+   tekuce klauze se zatvara
+   - lemom (isti literal je vec dokazan na nekoj ranijoj grani),
+   - redukcijom (unifikacijom sa komplementarnim literalom na putu od
+     korena), ili
+   - ekstenzijom (komplementarnim literalom preimenovane ulazne klauze,
+     ciji se ostali literali zatim dokazuju sa produzenim putem).
+   Put ne sme sadrzati isti literal dva puta (regularnost). Duzina puta je
+   ogranicena i ogranicenje se postepeno povecava do maxDepth (iterativno
+   produbljivanje), pa memorija raste linearno sa dubinom dokaza. Ako
+   pretraga nijednom ne dostigne ogranicenje, formula je zadovoljiva */
+ProofResult connection(Signature s, const Formula &f, const ProverOptions &opts);
+
+#endif
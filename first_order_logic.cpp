@@ -17,9 +17,11 @@ LiteralListList makePairs(const LiteralListList & c1, const LiteralListList & c2
 {
     LiteralListList c;
 
-    for(auto & l1 : c1)
+    for(auto & l1 : c1) {
+        throwIfCancelled();
         for(auto & l2 : c2)
             c.push_back(concatLists(l1, l2));
+    }
     return c;
 }
 
@@ -85,6 +87,149 @@ LiteralListList Quantifier::listDNF()
     throw "DNF not aplicable";
 }
 
+// Definiciona KNF -----------------------------------------------------
+
+/* Negacija literala, pri cemu se dvostruka negacija odmah eliminise */
+static Formula negateLiteral(const Formula & l)
+{
+    if(l->getType() == BaseFormula::T_NOT) {
+        return ((Not *) l.get())->getOperand();
+    }
+    return make_shared<Not>(l);
+}
+
+/* Uvodi novi atom d(x1,...,xn) za formulu f, gde su x1,...,xn slobodne
+   varijable formule f */
+static Formula definitionAtom(Signature & s, const Formula & f)
+{
+    VariableSet vars;
+    f->getVars(vars, true);
+
+    PredicateSymbol p = getUniquePredicateSymbol(s);
+    s.addPredicateSymbol(p, vars.size());
+
+    vector<Term> ops;
+    for(const Variable & v : vars) {
+        ops.push_back(make_shared<VariableTerm>(v));
+    }
+
+    return make_shared<Atom>(s, p, ops);
+}
+
+/* Konjunkcije na vrhu formule daju zasebne klauze, a disjunkcije na vrhu
+   klauze njene literale, pa za njih nisu potrebni novi simboli */
+static void topLevelClauses(const Formula & f, Signature & s, LiteralListList & clauses)
+{
+    if(f->getType() == BaseFormula::T_AND) {
+        topLevelClauses(((And *) f.get())->getOperand1(), s, clauses);
+        topLevelClauses(((And *) f.get())->getOperand2(), s, clauses);
+        return;
+    }
+
+    LiteralList clause;
+    vector<Formula> stack{f};
+    while(!stack.empty()) {
+        Formula g = stack.back();
+        stack.pop_back();
+        if(g->getType() == BaseFormula::T_OR) {
+            stack.push_back(((Or *) g.get())->getOperand2());
+            stack.push_back(((Or *) g.get())->getOperand1());
+        } else {
+            clause.push_back(g->definitional(s, clauses));
+        }
+    }
+    clauses.push_back(clause);
+}
+
+LiteralListList BaseFormula::definitionalCNF(Signature & s)
+{
+    /* Simplifikacijom se uklanjaju logicke konstante iz unutrasnjosti
+    formule, pa konstanta moze ostati samo kao cela formula */
+    Formula simp = shared_from_this()->simplify();
+
+    if(simp->getType() == T_TRUE) {
+        return {};
+    } else if(simp->getType() == T_FALSE) {
+        return {{}};
+    }
+
+    LiteralListList clauses;
+    topLevelClauses(simp, s, clauses);
+    return clauses;
+}
+
+Formula AtomicFormula::definitional(Signature &, LiteralListList &)
+{
+    return shared_from_this();
+}
+
+Formula Not::definitional(Signature & s, LiteralListList & clauses)
+{
+    if(_op->getType() == T_ATOM) {
+        return shared_from_this();
+    }
+    return negateLiteral(_op->definitional(s, clauses));
+}
+
+Formula And::definitional(Signature & s, LiteralListList & clauses)
+{
+    /* d <=> (A /\ B) daje klauze ~d \/ A, ~d \/ B, d \/ ~A \/ ~B */
+    Formula l1 = _op1->definitional(s, clauses);
+    Formula l2 = _op2->definitional(s, clauses);
+    Formula d = definitionAtom(s, shared_from_this());
+
+    clauses.push_back({ negateLiteral(d), l1 });
+    clauses.push_back({ negateLiteral(d), l2 });
+    clauses.push_back({ d, negateLiteral(l1), negateLiteral(l2) });
+    return d;
+}
+
+Formula Or::definitional(Signature & s, LiteralListList & clauses)
+{
+    /* d <=> (A \/ B) daje klauze ~d \/ A \/ B, d \/ ~A, d \/ ~B */
+    Formula l1 = _op1->definitional(s, clauses);
+    Formula l2 = _op2->definitional(s, clauses);
+    Formula d = definitionAtom(s, shared_from_this());
+
+    clauses.push_back({ negateLiteral(d), l1, l2 });
+    clauses.push_back({ d, negateLiteral(l1) });
+    clauses.push_back({ d, negateLiteral(l2) });
+    return d;
+}
+
+Formula Imp::definitional(Signature & s, LiteralListList & clauses)
+{
+    /* d <=> (A ==> B) daje klauze ~d \/ ~A \/ B, d \/ A, d \/ ~B */
+    Formula l1 = _op1->definitional(s, clauses);
+    Formula l2 = _op2->definitional(s, clauses);
+    Formula d = definitionAtom(s, shared_from_this());
+
+    clauses.push_back({ negateLiteral(d), negateLiteral(l1), l2 });
+    clauses.push_back({ d, l1 });
+    clauses.push_back({ d, negateLiteral(l2) });
+    return d;
+}
+
+Formula Iff::definitional(Signature & s, LiteralListList & clauses)
+{
+    /* d <=> (A <=> B) daje klauze ~d \/ ~A \/ B, ~d \/ A \/ ~B,
+    d \/ A \/ B, d \/ ~A \/ ~B. Za razliku od nnf(), formula se ne duplira */
+    Formula l1 = _op1->definitional(s, clauses);
+    Formula l2 = _op2->definitional(s, clauses);
+    Formula d = definitionAtom(s, shared_from_this());
+
+    clauses.push_back({ negateLiteral(d), negateLiteral(l1), l2 });
+    clauses.push_back({ negateLiteral(d), l1, negateLiteral(l2) });
+    clauses.push_back({ d, l1, l2 });
+    clauses.push_back({ d, negateLiteral(l1), negateLiteral(l2) });
+    return d;
+}
+
+Formula Quantifier::definitional(Signature &, LiteralListList &)
+{
+    throw "Definitional form not applicable";
+}
+
 // Funkcije substitucije -----------------------------------------------
 
 Term VariableTerm::substitute(const Variable & v, const Term & t)
@@ -204,14 +349,9 @@ bool FunctionTerm::equalTo(const Term & t) const
     if(_ops.size() != t_ops.size())
         return false;
 
-    if (_ops.size() == 0) {
-        return true;
-    }
-
     if(_f != ((FunctionTerm *) t.get())->getSymbol())
         return false;
 
-
     for(unsigned i = 0; i < _ops.size(); i++) {
         if(!_ops[i]->equalTo(t_ops[i])) {
             return false;
@@ -657,9 +797,12 @@ bool Exists::eval(const Structure & st, const Valuation & val) const
 
 // Klasa Signature -------------------------------------------------------
 
-size_t Signature::_currUniq = 0;
+thread_local size_t Signature::_currUniq = 0;
+
+const PredicateSymbol Signature::EQUALITY = "=";
 
 Signature::Signature()
+    : _equality(false)
 {
     for (size_t i = 0; i < MAX_UNIQUE_CTS; ++i) {
         std::stringstream ss;
@@ -699,6 +842,32 @@ bool Signature::checkFunctionSymbol(const FunctionSymbol & f, unsigned & arity)
     }
 }
 
+const map<FunctionSymbol, unsigned> & Signature::getFunctionSymbols() const
+{
+    return _functions;
+}
+
+const map<PredicateSymbol, unsigned> & Signature::getPredicateSymbols() const
+{
+    return _predicates;
+}
+
+void Signature::addEquality()
+{
+    addPredicateSymbol(EQUALITY, 2);
+    _equality = true;
+}
+
+bool Signature::hasEquality() const
+{
+    return _equality;
+}
+
+bool Signature::isEquality(const PredicateSymbol & p) const
+{
+    return _equality && p == EQUALITY;
+}
+
 bool Signature::checkPredicateSymbol(const PredicateSymbol & f, unsigned & arity) const
 {
     map<PredicateSymbol, unsigned>::const_iterator it = _predicates.find(f);
@@ -795,6 +964,122 @@ Relation * Structure::getRelation(const PredicateSymbol & p) const
     }
 }
 
+/* Broj celija tablice za datu arnost, ili 0 ako je tablica prevelika */
+static size_t tableSize(unsigned radix, unsigned arity)
+{
+    size_t size = 1;
+    for(unsigned i = 0; i < arity; i++) {
+        size *= radix;
+        if(size > MAX_TABULATED_ENTRIES) {
+            return 0;
+        }
+    }
+    return size;
+}
+
+void Structure::tabulate()
+{
+    /* Tablice se indeksiraju samim vrednostima iz domena, pa je osnova
+    najveca vrednost u domenu uvecana za jedan */
+    if(_domain.empty()) {
+        return;
+    }
+
+    unsigned radix = 0;
+    for(unsigned i = 0; i < _domain.size(); i++) {
+        radix = max(radix, _domain[i] + 1);
+    }
+
+    vector<bool> inDomain(radix, false);
+    for(unsigned i = 0; i < _domain.size(); i++) {
+        inDomain[_domain[i]] = true;
+    }
+
+    /* Tablice se citaju i ugnjezdeno (vrednost jedne funkcije je argument
+    druge), pa se tabelira samo ako su sve funkcije zatvorene nad domenom;
+    inace bi indeks tablice ukazivao na pogresnu celiju ili izasao van nje.
+    Funkcija cija je tablica prevelika da bi se proverila se smatra
+    nezatvorenom, pa se tada ne tabelira nista */
+    map<FunctionSymbol, vector<unsigned> > tables;
+    for(auto & p : _funs) {
+        unsigned arity = p.second->getArity();
+        size_t size = tableSize(radix, arity);
+        if(size == 0) {
+            return;
+        }
+
+        vector<unsigned> table(size, 0);
+        vector<unsigned> args(arity, 0);
+        vector<unsigned> pos(arity, 0);
+        do {
+            size_t index = 0;
+            for(unsigned i = 0; i < arity; i++) {
+                args[i] = _domain[pos[i]];
+                index = index * radix + args[i];
+            }
+            table[index] = p.second->eval(args);
+            if(table[index] >= radix || !inDomain[table[index]]) {
+                return;
+            }
+
+            /* Sledeca n-torka indeksa domena */
+            unsigned i = arity;
+            while(i > 0 && ++pos[i - 1] == _domain.size()) {
+                pos[--i] = 0;
+            }
+            if(i == 0) {
+                break;
+            }
+        } while(true);
+
+        if(dynamic_cast<TableFunction *>(p.second) == NULL) {
+            tables[p.first].swap(table);
+        }
+    }
+
+    for(auto & p : _funs) {
+        auto it = tables.find(p.first);
+        if(it == tables.end()) {
+            continue;
+        }
+        Function * tab = new TableFunction(p.second->getArity(), radix, it->second);
+        delete p.second;
+        p.second = tab;
+    }
+
+    for(auto & p : _rels) {
+        unsigned arity = p.second->getArity();
+        size_t size = tableSize(radix, arity);
+        if(size == 0 || dynamic_cast<TableRelation *>(p.second) != NULL) {
+            continue;
+        }
+
+        vector<bool> table(size, false);
+        vector<unsigned> args(arity, 0);
+        vector<unsigned> pos(arity, 0);
+        do {
+            size_t index = 0;
+            for(unsigned i = 0; i < arity; i++) {
+                args[i] = _domain[pos[i]];
+                index = index * radix + args[i];
+            }
+            table[index] = p.second->eval(args);
+
+            unsigned i = arity;
+            while(i > 0 && ++pos[i - 1] == _domain.size()) {
+                pos[--i] = 0;
+            }
+            if(i == 0) {
+                break;
+            }
+        } while(true);
+
+        Relation * tab = new TableRelation(arity, radix, table);
+        delete p.second;
+        p.second = tab;
+    }
+}
+
 Structure::~Structure()
 {
     for(const auto & p : _funs) {
@@ -927,7 +1212,7 @@ bool BaseFormula::containsVariable(const Variable & v, bool free) const
 template <typename T1, typename T2>
 Variable getUniqueVariable(const T1 & e1, const T2 & e2)
 {
-    static unsigned i = 0;
+    static thread_local unsigned i = 0;
 
     Variable v;
 
@@ -952,7 +1237,7 @@ Formula removeUniversalQ(const Formula & f) {
 
 FunctionSymbol getUniqueFunctionSymbol(const Signature & s)
 {
-    static unsigned i = 0;
+    static thread_local unsigned i = 0;
     unsigned arity;
 
     FunctionSymbol f;
@@ -964,6 +1249,20 @@ FunctionSymbol getUniqueFunctionSymbol(const Signature & s)
     return f;
 }
 
+PredicateSymbol getUniquePredicateSymbol(const Signature & s)
+{
+    static thread_local unsigned i = 0;
+    unsigned arity;
+
+    PredicateSymbol p;
+
+    do {
+        p = string("up") + to_string(++i);
+    } while(s.checkPredicateSymbol(p, arity));
+
+    return p;
+}
+
 // ----------------------------------------------------------------------
 
 // Klasa AtomicFormula --------------------------------------------------
@@ -1693,6 +1992,154 @@ Formula Exists::prenex()
 
 // -----------------------------------------------------------------------
 
+// Funkcije za spustanje kvantifikatora (miniscoping) -------------------
+
+/* Pomocna funkcija koja "spljostava" niz istih binarnih veznika, npr.
+   (A /\ B) /\ C daje listu [A, B, C] */
+static void flattenConnective(const Formula & f, BaseFormula::Type type, vector<Formula> & ops)
+{
+    if(f->getType() == type) {
+        BinaryConnective * bc = (BinaryConnective *) f.get();
+        flattenConnective(bc->getOperand1(), type, ops);
+        flattenConnective(bc->getOperand2(), type, ops);
+    } else {
+        ops.push_back(f);
+    }
+}
+
+/* Inverzna funkcija od flattenConnective, lista mora biti neprazna */
+static Formula buildConnective(const vector<Formula> & ops, BaseFormula::Type type)
+{
+    Formula res = ops[0];
+    for(unsigned i = 1; i < ops.size(); i++) {
+        if(type == BaseFormula::T_AND) {
+            res = make_shared<And>(res, ops[i]);
+        } else {
+            res = make_shared<Or>(res, ops[i]);
+        }
+    }
+    return res;
+}
+
+static Formula pushQuantifier(BaseFormula::Type quant, const Variable & v, const Formula & op);
+
+/* Kvantifikator (Q x) se distribuira kroz veznik sa kojim komutira
+   ((forall x) kroz /\, (exists x) kroz \/), dok se kroz drugi veznik
+   izvlace samo operandi u kojima se x ne pojavljuje slobodno */
+static Formula pushThroughConnective(BaseFormula::Type quant, const Variable & v,
+                                     const Formula & op, BaseFormula::Type distributes)
+{
+    vector<Formula> ops;
+    flattenConnective(op, op->getType(), ops);
+
+    if(op->getType() == distributes) {
+        for(unsigned i = 0; i < ops.size(); i++) {
+            ops[i] = pushQuantifier(quant, v, ops[i]);
+        }
+        return buildConnective(ops, op->getType());
+    }
+
+    vector<Formula> with, without;
+    for(unsigned i = 0; i < ops.size(); i++) {
+        if(ops[i]->containsVariable(v, true)) {
+            with.push_back(ops[i]);
+        } else {
+            without.push_back(ops[i]);
+        }
+    }
+
+    if(without.empty()) {
+        if(quant == BaseFormula::T_FORALL) {
+            return make_shared<Forall>(v, op);
+        } else {
+            return make_shared<Exists>(v, op);
+        }
+    }
+
+    without.push_back(pushQuantifier(quant, v, buildConnective(with, op->getType())));
+    return buildConnective(without, op->getType());
+}
+
+/* Funkcija spusta kvantifikator (Q x) u formulu op, za koju se
+   podrazumeva da je vec obradjena miniscope() funkcijom */
+static Formula pushQuantifier(BaseFormula::Type quant, const Variable & v, const Formula & op)
+{
+    /* Nepotreban kvantifikator se brise */
+    if(!op->containsVariable(v, true)) {
+        return op;
+    }
+
+    BaseFormula::Type dual = quant == BaseFormula::T_FORALL ?
+        BaseFormula::T_AND : BaseFormula::T_OR;
+
+    if(op->getType() == BaseFormula::T_AND || op->getType() == BaseFormula::T_OR) {
+        return pushThroughConnective(quant, v, op, dual);
+    } else if(op->getType() == quant) {
+        /* Istoimeni kvantifikatori komutiraju, pa (Q x)(Q y) A svodimo na
+        (Q y) A', gde je A' rezultat spustanja (Q x) u A. Na taj nacin se
+        x spusta sto dublje, nezavisno od redosleda u polaznoj formuli */
+        Quantifier * q = (Quantifier *) op.get();
+        Formula inner = pushQuantifier(quant, v, q->getOperand());
+        if(quant == BaseFormula::T_FORALL) {
+            return make_shared<Forall>(q->getVariable(), inner);
+        } else {
+            return make_shared<Exists>(q->getVariable(), inner);
+        }
+    }
+
+    if(quant == BaseFormula::T_FORALL) {
+        return make_shared<Forall>(v, op);
+    } else {
+        return make_shared<Exists>(v, op);
+    }
+}
+
+Formula AtomicFormula::miniscope()
+{
+    return shared_from_this();
+}
+
+Formula Not::miniscope()
+{
+    /* Formula je u NNF-u, pa je negacija primenjena samo na atom */
+    return shared_from_this();
+}
+
+Formula And::miniscope()
+{
+    return make_shared<And>(_op1->miniscope(), _op2->miniscope());
+}
+
+Formula Or::miniscope()
+{
+    return make_shared<Or>(_op1->miniscope(), _op2->miniscope());
+}
+
+Formula Imp::miniscope()
+{
+    /* Implikacija ne bi trebalo da se pojavi, jer je formula vec u NNF-u */
+    throw "Miniscope not applicable";
+}
+
+Formula Iff::miniscope()
+{
+    /* Ekvivalencija ne bi trebalo da se pojavi, jer je formula vec u NNF-u */
+    throw "Miniscope not applicable";
+}
+
+Formula Forall::miniscope()
+{
+    /* Najpre se spustaju unutrasnji kvantifikatori, a zatim i (forall x) */
+    return pushQuantifier(T_FORALL, _v, _op->miniscope());
+}
+
+Formula Exists::miniscope()
+{
+    return pushQuantifier(T_EXISTS, _v, _op->miniscope());
+}
+
+// -----------------------------------------------------------------------
+
 // Funkcije za skolemizaciju ---------------------------------------------
 
 /* Kod funkcija za skolemizaciju, podrazumeva se da je formula u PRENEX
@@ -1700,12 +2147,29 @@ Formula Exists::prenex()
    Qi \in {forall, exists}, dok je A formula bez kvantifikatora koja ne
    sadrzi druge varijable osim x1,...,xn */
 
+/* Formula moze biti i u obliku dobijenom funkcijom miniscope(), kada se
+   kvantifikatori nalaze i unutar konjunkcija i disjunkcija. Tada se
+   skolemizacija nastavlja u oba operanda, sa istim univerzalnim
+   varijablama */
+
 Formula BaseFormula::skolem(Signature &, vector<Variable> &&)
 {
     /* Podrazumevano, za formulu bez kvantifikatora, ne radimo nista */
     return shared_from_this();
 }
 
+Formula And::skolem(Signature & s, vector<Variable> && vars)
+{
+    return make_shared<And>(_op1->skolem(s, vector<Variable>(vars)),
+        _op2->skolem(s, std::move(vars)));
+}
+
+Formula Or::skolem(Signature & s, vector<Variable> && vars)
+{
+    return make_shared<Or>(_op1->skolem(s, vector<Variable>(vars)),
+        _op2->skolem(s, std::move(vars)));
+}
+
 Formula Forall::skolem(Signature & s, vector<Variable> && vars)
 {
     /* Ako je formula oblika (forall x) A, tada samo dodajemo varijablu
@@ -1852,3 +2316,48 @@ bool LowerOrEqual::eval(const vector<unsigned> & args) {
     return args[0] <= args[1];
 }
 
+TableFunction::TableFunction(unsigned arity, unsigned domain_size, const vector<unsigned> & table)
+    : Function(arity), _domain_size(domain_size), _table(table)
+{
+    for(unsigned v : _table) {
+        if(v >= _domain_size) {
+            throw "Table value outside domain";
+        }
+    }
+}
+
+unsigned TableFunction::eval(const vector<unsigned> & args) {
+    if(args.size() != getArity()) {
+        throw "Arguments number mismatch";
+    }
+
+    size_t index = 0;
+    for(unsigned i = 0; i < args.size(); i++) {
+        if(args[i] >= _domain_size) {
+            throw "Argument outside table";
+        }
+        index = index * _domain_size + args[i];
+    }
+
+    return _table[index];
+}
+
+TableRelation::TableRelation(unsigned arity, unsigned domain_size, const vector<bool> & table)
+    : Relation(arity), _domain_size(domain_size), _table(table.begin(), table.end())
+{}
+
+bool TableRelation::eval(const vector<unsigned> & args) {
+    if(args.size() != getArity()) {
+        throw "Arguments number mismatch";
+    }
+
+    size_t index = 0;
+    for(unsigned i = 0; i < args.size(); i++) {
+        if(args[i] >= _domain_size) {
+            throw "Argument outside table";
+        }
+        index = index * _domain_size + args[i];
+    }
+
+    return _table[index];
+}
@@ -11,6 +11,8 @@
 #include <memory>
 #include <functional>
 
+#include "cancellation.h"
+
 using namespace std;
 
 /* Funkcijski i predikatski simboli */
@@ -24,7 +26,10 @@ private:
     map<FunctionSymbol,  unsigned> _functions;
     map<PredicateSymbol, unsigned> _predicates;
     vector<FunctionSymbol> _uniqueConstants;
-    static size_t _currUniq;
+    bool _equality;
+    /* Brojac (kao i brojaci u getUnique* funkcijama) je lokalan za nit,
+    pa dokazivanja u razlicitim nitima ne dele stanje */
+    static thread_local size_t _currUniq;
 public:
     Signature();
 
@@ -42,6 +47,20 @@ public:
 
     /* Provera da li postoji dati predikatski simbol, i koja mu je arnost */
     bool checkPredicateSymbol(const PredicateSymbol & f, unsigned & arity) const;
+
+    /* Svi funkcijski, odnosno predikatski simboli sa arnostima */
+    const map<FunctionSymbol, unsigned> & getFunctionSymbols() const;
+    const map<PredicateSymbol, unsigned> & getPredicateSymbols() const;
+
+    /* Simbol jednakosti. Ako je dodat funkcijom addEquality, atomi sa ovim
+    simbolom se ne tumace kao obican predikat, vec kao jednakost (osnovne
+    instance se proveravaju kongruentnim zatvorenjem, a u pretrazi modela
+    je jednakost identitet) */
+    static const PredicateSymbol EQUALITY;
+
+    void addEquality();
+    bool hasEquality() const;
+    bool isEquality(const PredicateSymbol & p) const;
 };
 
 
@@ -204,10 +223,27 @@ public:
     /* Funkcija svodi formulu na PRENEX */
     virtual Formula prenex() = 0;
 
+    /* Funkcija spusta kvantifikatore sto dublje u formulu (miniscoping),
+    cime se smanjuje arnost Skolemovih funkcija. Podrazumeva se da je
+    formula u NNF-u */
+    virtual Formula miniscope() = 0;
+
     /* Funkcija za skolemizaciju */
     virtual Formula skolem(Signature & s, vector<Variable> && vars = vector<Variable>());
 
     virtual LiteralListList listDNF() = 0;
+
+    /* Funkcija svodi formulu bez kvantifikatora na definicionu (Cajtinovu)
+    KNF. Vraca listu klauza (disjunkcija literala) koja je zadovoljiva akko
+    je formula zadovoljiva. Za svaku slozenu podformulu se u signaturu uvodi
+    novi predikatski simbol, pa je velicina rezultata linearna u odnosu na
+    velicinu formule */
+    LiteralListList definitionalCNF(Signature & s);
+
+    /* Pomocna funkcija za definicionu KNF: vraca literal koji zamenjuje
+    formulu i u clauses dodaje klauze koje ga definisu */
+    virtual Formula definitional(Signature & s, LiteralListList & clauses) = 0;
+
     virtual ~BaseFormula() {}
 };
 
@@ -223,14 +259,19 @@ Formula removeUniversalQ(const Formula & f);
 /* Funkcija vraca novi funkcijski simbol koji se ne pojavljuje u formuli */
 FunctionSymbol getUniqueFunctionSymbol(const Signature & s);
 
+/* Funkcija vraca novi predikatski simbol koji ne postoji u signaturi */
+PredicateSymbol getUniquePredicateSymbol(const Signature & s);
+
 /* Klasa predstavlja sve atomicke formule (True, False i Atom) */
 class AtomicFormula : public BaseFormula {
 public:
     virtual unsigned complexity() const;
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
     virtual Formula simplify();
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
 };
 
 /* Klasa predstavlja logicke konstante (True i False) */
@@ -318,7 +359,9 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
 };
 
 /* Klasa predstavlja sve binarne veznike */
@@ -349,7 +392,10 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
+    virtual Formula skolem(Signature & s, vector<Variable> && vars);
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
  };
 
 
@@ -366,7 +412,10 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
+    virtual Formula skolem(Signature & s, vector<Variable> && vars);
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
 };
 
 /* Klasa predstavlja implikaciju */
@@ -382,7 +431,9 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
 };
 
 
@@ -399,7 +450,9 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
 };
 
 /* Klasa predstavlja kvantifikovane formule */
@@ -419,6 +472,7 @@ public:
     virtual void getFunctions(FunctionSet & vars) const;
     // ne moze
     virtual LiteralListList listDNF();
+    virtual Formula definitional(Signature & s, LiteralListList & clauses);
 };
 
 /* Klasa predstavlja univerzalno kvantifikovanu formulu */
@@ -434,6 +488,7 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
     virtual Formula skolem(Signature & s, vector<Variable> && vars);
 };
 
@@ -451,6 +506,7 @@ public:
     virtual Formula nnf();
     virtual Formula pullquants();
     virtual Formula prenex();
+    virtual Formula miniscope();
     virtual Formula skolem(Signature & s, vector<Variable> && vars);
 };
 
@@ -515,6 +571,13 @@ public:
     /* Citanje interpretacije datog predikatskog simbola */
     Relation * getRelation(const PredicateSymbol & p) const;
 
+    /* Zamenjuje interpretacije funkcijskih i predikatskih simbola tablicama
+    (TableFunction i TableRelation), izracunatim jednom nad svim n-torkama
+    domena. Preskacu se simboli cije bi tablice bile prevelike, a ako
+    neka funkcija nije zatvorena nad domenom (ili je prevelika da bi se to
+    proverilo), ne tabelira se nista */
+    void tabulate();
+
     ~Structure();
 };
 
@@ -598,6 +661,53 @@ public:
     virtual bool eval(const vector<unsigned> & args);
 };
 
+/* Klasa predstavlja funkciju zadatu tablicom vrednosti, za argumente iz
+   skupa {0,...,n-1}. Vrednost za argumente (a1,...,ak) se nalazi na
+   poziciji a1*n^(k-1) + ... + ak, pa se funkcija izracunava jednim
+   citanjem iz memorije. Pored virtuelne funkcije eval, za poznatu arnost
+   se moze koristiti i lookup<k>, bez virtuelnog poziva i provera; zato
+   konstruktor proverava da su sve vrednosti tablice manje od n */
+class TableFunction : public Function {
+private:
+    unsigned _domain_size;
+    vector<unsigned> _table;
+public:
+    TableFunction(unsigned arity, unsigned domain_size, const vector<unsigned> & table);
+    virtual unsigned eval(const vector<unsigned> & args);
+
+    template <unsigned N>
+    unsigned lookup(const unsigned * args) const
+    {
+        size_t index = 0;
+        for(unsigned i = 0; i < N; i++) {
+            index = index * _domain_size + args[i];
+        }
+        return _table[index];
+    }
+};
+
+/* Klasa predstavlja relaciju zadatu tablicom istinitosnih vrednosti (u
+   istom rasporedu kao kod TableFunction) */
+class TableRelation : public Relation {
+private:
+    unsigned _domain_size;
+    vector<unsigned char> _table;
+public:
+    TableRelation(unsigned arity, unsigned domain_size, const vector<bool> & table);
+    virtual bool eval(const vector<unsigned> & args);
+
+    template <unsigned N>
+    bool lookup(const unsigned * args) const
+    {
+        size_t index = 0;
+        for(unsigned i = 0; i < N; i++) {
+            index = index * _domain_size + args[i];
+        }
+        return _table[index];
+    }
+};
 
+/* Najveca velicina tablice koju pravi Structure::tabulate */
+const size_t MAX_TABULATED_ENTRIES = (size_t)1 << 24;
 
 #endif
@@ -1,99 +1,737 @@
 #include "gilmore.h"
 #include "herbrand.h"
+#include "ground.h"
+#include "sat.h"
+#include "bdd.h"
+#include "zdd.h"
+#include "conjunct_store.h"
+#include "checkpoint.h"
+#include "certificate.h"
+#include "model_search.h"
+#include "congruence.h"
+#include "resolution.h"
+#include "instgen.h"
+#include "connection.h"
+#include "portfolio.h"
 
 #include <algorithm>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <chrono>
 
 const size_t MAX_ITERATIONS = 5;
 
-void prove(Signature s, const Formula &f)
+static ProofResult dispatch(Signature &s, const Formula &f, const ProverOptions &opts)
 {
-    gilmore(s, std::make_shared<Not>(f));
+    if (opts.strategy == S_RESOLUTION) {
+        /* Za formulu oblika A => B, klauze negiranog zakljucka cine skup
+        potpore */
+        if (f->getType() == BaseFormula::T_IMP) {
+            return resolution(s, ((Imp*)f.get())->getOperand1(),
+                              std::make_shared<Not>(((Imp*)f.get())->getOperand2()), opts);
+        }
+        return resolution(s, Formula(), std::make_shared<Not>(f), opts);
+    }
+
+    if (opts.strategy == S_INSTGEN) {
+        return instGen(s, std::make_shared<Not>(f), opts);
+    }
+
+    if (opts.strategy == S_CONNECTION) {
+        return connection(s, std::make_shared<Not>(f), opts);
+    }
+
+    if (opts.strategy == S_PORTFOLIO) {
+        return portfolio(s, f, opts);
+    }
+
+    return gilmore(s, std::make_shared<Not>(f), opts);
 }
 
-void gilmore(Signature s, const Formula &f)
+ProofResult prove(Signature s, const Formula &f, const ProverOptions &opts)
 {
-    auto tf = removeUniversalQ(f->nnf()->prenex()->skolem(s));
+    CancellationScope scope(opts.cancellation);
+    try {
+        return dispatch(s, f, opts);
+    } catch (const ProofCancelled &) {
+        return PR_UNKNOWN;
+    }
+}
 
-    HerbrandUniverse universe(s, tf);
-    VariableSet v;
-    tf->getVars(v);
-    std::vector<Variable> variables;
+std::future<ProofResult> proveAsync(const Signature &s, const Formula &f, const ProverOptions &opts,
+                                    const CancellationToken *token)
+{
+    ProverOptions o = opts;
+    if (token) {
+        o.cancellation = token;
+    }
+    return std::async(std::launch::async, [s, f, o]() { return prove(s, f, o); });
+}
 
-    std::copy(v.begin(), v.end(), std::back_inserter(variables));
+Formula skolemMatrix(Signature &s, const Formula &f, const ProverOptions &opts)
+{
+    if (opts.miniscope) {
+        /* Skolemizacija posle miniscoping-a daje formulu sa univerzalnim
+        kvantifikatorima unutar konjunkcija i disjunkcija, pa se tek tada
+        svodi na PRENEX */
+        return removeUniversalQ(f->nnf()->miniscope()->skolem(s)->prenex());
+    }
 
-    size_t nvars = variables.size();
+    return removeUniversalQ(f->nnf()->prenex()->skolem(s));
+}
 
-    size_t iteration;
-    for (iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
-        std::vector< std::vector<Term> > substitutions =
-            product(universe.level(), nvars);
+std::vector<InstantiationUnit> instantiationUnits(const Formula &tf, const ProverOptions &opts)
+{
+    std::vector<InstantiationUnit> units;
+
+    if (!opts.perClause) {
+        InstantiationUnit unit;
+        unit.matrix = tf;
+        VariableSet v;
+        tf->getVars(v);
+        std::copy(v.begin(), v.end(), std::back_inserter(unit.variables));
+        units.push_back(unit);
+        return units;
+    }
+
+    /* Matrica se deli na konjunkte, (A x)(C1 /\ C2) je ekvivalentno sa
+    (A x)C1 /\ (A x)C2, pa svaki konjunkt instanciramo samo po njegovim
+    varijablama */
+    std::vector<Formula> conjuncts;
+    std::vector<Formula> stack{tf};
+    while (!stack.empty()) {
+        Formula c = stack.back();
+        stack.pop_back();
+        if (c->getType() == BaseFormula::T_AND) {
+            stack.push_back(((And*)c.get())->getOperand2());
+            stack.push_back(((And*)c.get())->getOperand1());
+        } else {
+            conjuncts.push_back(c);
+        }
+    }
+
+    VariableSet used;
+    tf->getVars(used);
+
+    for (size_t i = 0; i < conjuncts.size(); ++i) {
+        InstantiationUnit unit;
+        unit.matrix = conjuncts[i];
 
-        Formula sub = tf;
+        VariableSet v;
+        conjuncts[i]->getVars(v);
 
-        for (size_t i = 0; i < nvars; ++i) {
-            sub = sub->substitute(variables[i], substitutions[0][i]);
+        /* Preimenovanje varijabli, tako da konjunkti nemaju zajednickih
+        varijabli */
+        for (const Variable &var : v) {
+            Variable renamed;
+            size_t k = 0;
+            do {
+                renamed = var + "_" + std::to_string(i) + (k ? "_" + std::to_string(k) : "");
+                ++k;
+            } while (used.find(renamed) != used.end());
+            used.insert(renamed);
+
+            unit.matrix = unit.matrix->substitute(var, std::make_shared<VariableTerm>(renamed));
+            unit.variables.push_back(renamed);
         }
+        units.push_back(unit);
+    }
+
+    return units;
+}
+
+std::vector<Formula> groundInstances(const std::vector<InstantiationUnit> &units, const std::set<Term> &level)
+{
+    std::vector<Formula> instances;
+
+    for (const InstantiationUnit &unit : units) {
+        size_t nvars = unit.variables.size();
+        std::vector< std::vector<Term> > substitutions = product(level, nvars);
 
-        for (size_t i = 1; i < substitutions.size(); ++i) {
-            Formula nsub = tf;
+        for (size_t i = 0; i < substitutions.size(); ++i) {
+            throwIfCancelled();
+            Formula nsub = unit.matrix;
             for (size_t j = 0; j < nvars; ++j) {
-                nsub = nsub->substitute(variables[j], substitutions[i][j]);
+                nsub = nsub->substitute(unit.variables[j], substitutions[i][j]);
+            }
+            instances.push_back(nsub);
+        }
+    }
+
+    return instances;
+}
+
+Formula clausesToFormula(const LiteralListList &clauses)
+{
+    if (clauses.empty()) {
+        return std::make_shared<True>();
+    }
+
+    Formula res;
+    for (const LiteralList &clause : clauses) {
+        Formula c;
+        if (clause.empty()) {
+            c = std::make_shared<False>();
+        } else {
+            c = clause[0];
+            for (size_t i = 1; i < clause.size(); ++i) {
+                c = std::make_shared<Or>(c, clause[i]);
+            }
+        }
+        res = res ? std::make_shared<And>(res, c) : c;
+    }
+    return res;
+}
+
+/* Periodicno zapisivanje stanja procedure u kontrolnu tacku */
+class Checkpointer {
+    const Signature &m_signature;
+    const ProverOptions &m_opts;
+    std::chrono::steady_clock::time_point m_saved;
+public:
+    Checkpoint state;
+
+    Checkpointer(const Signature &s, const ProverOptions &opts)
+        : m_signature(s), m_opts(opts), m_saved(std::chrono::steady_clock::now())
+    {}
+
+    bool enabled() const
+    {
+        return !m_opts.checkpointFile.empty();
+    }
+
+    /* Da li je od poslednjeg zapisivanja proslo vise od zadatog intervala */
+    bool due() const
+    {
+        return enabled() && std::chrono::steady_clock::now() - m_saved >= std::chrono::seconds(m_opts.checkpointInterval);
+    }
+
+    /* Da li je zapisana kontrolna tacka nastala za formulu f i istu
+       pripremu. Cita se uz privremenu signaturu, da se simboli kontrolne
+       tacke druge formule ne bi dodali u signaturu dokazivanja */
+    bool matches(const Formula &f) const
+    {
+        Signature s;
+        Checkpoint c;
+        return loadCheckpoint(m_opts.checkpointFile, s, c) && c.formula->equalTo(f) &&
+               c.miniscope == m_opts.miniscope && c.clausal == m_opts.clausal;
+    }
+
+    void save(const AtomTable &atoms)
+    {
+        state.atoms.clear();
+        for (unsigned id = 0; id < atoms.size(); ++id) {
+            state.atoms.push_back(atoms.atom(id));
+        }
+        saveCheckpoint(m_opts.checkpointFile, m_signature, state);
+        m_saved = std::chrono::steady_clock::now();
+    }
+};
+
+/* Gilmorova metoda multiplikacije: konjunkcija instanci se svodi na DNF i
+   proverava se da li svaka konjunkcija sadrzi komplementaran par literala,
+   odnosno (ako signatura ima jednakost) da li je nesaglasna sa teorijom
+   jednakosti. Konjunkcije su skupovi bitova nad tabelom atoma koja se
+   cuva kroz nivoe, a zatvorene konjunkcije se odbacuju vec tokom
+   multiplikacije, jer nijedna njihova unija ne moze biti otvorena. Ako
+   je zadata kontrolna tacka sa zapocetim nivoom, multiplikacija se
+   nastavlja od njenih preostalih konjunkcija */
+static bool refuteDNF(const std::vector<Formula> &instances, AtomTable &atoms, const ProverOptions &opts, bool equality,
+                      Checkpointer *checkpoint = nullptr)
+{
+    std::vector<BitConjunct> dnf(1);
+    size_t first = 0;
+    if (checkpoint && !checkpoint->state.instances.empty()) {
+        dnf.clear();
+        for (const Clause &conjunct : checkpoint->state.conjuncts) {
+            dnf.push_back(BitConjunct());
+            for (Lit l : conjunct) {
+                dnf.back().add(l);
             }
+        }
+        first = checkpoint->state.processed;
+    }
 
-            sub = std::make_shared<And>(sub, nsub);
+    for (size_t i = first; i < instances.size(); ++i) {
+        if (opts.cancelled()) {
+            return false;
+        }
+        dnf = multiplyDNF(dnf, bitDNF(instances[i], atoms));
+        if (dnf.empty()) {
+            return true;
         }
 
-        LiteralListList dnf = sub->listDNF();
+        if (checkpoint && checkpoint->due()) {
+            checkpoint->state.instances = instances;
+            checkpoint->state.processed = i + 1;
+            checkpoint->state.conjuncts.clear();
+            for (const BitConjunct &c : dnf) {
+                checkpoint->state.conjuncts.push_back(c.encoded());
+            }
+            checkpoint->save(atoms);
+        }
+    }
 
-        size_t removeCount = 0;
+    size_t removeCount = 0;
 
-        for (LiteralList conjuncts : dnf) {
-            LiteralList positive;
-            LiteralList negative;
-            bool found = false;
+    for (const BitConjunct &c : dnf) {
+        throwIfCancelled();
+        LiteralList conjuncts = c.literals(atoms);
 
+        if (equality && !consistentLiterals(conjuncts)) {
+            removeCount += 1;
+        } else if (opts.verbose) {
+            std::cout << "Conjunctions not removed: [";
             for (auto literal : conjuncts) {
-                if (literal->getType() == BaseFormula::T_NOT) {
-                    Formula t = ((Not*)literal.get())->getOperand();
-                    if (std::find_if(positive.begin(), positive.end(),
-                                [t](const Formula &x) { return x->equalTo(t); }) != positive.end()) {
-                        found = true;
-                        removeCount += 1;
-                        break;
-                    } else {
-                        negative.push_back(t);
-                    }
-                } else if (literal->getType() == BaseFormula::T_ATOM) {
-                    if (std::find_if(negative.begin(), negative.end(),
-                                [literal](const Formula &x) { return x->equalTo(literal); }) != negative.end()) {
-                        found = true;
-                        removeCount += 1;
-                        break;
-                    } else {
-                        positive.push_back(literal);
-                    }
-                } else {
-                    throw "Bad type";
+                std::cout << literal << ", ";
+            }
+            std::cout << "]" << std::endl;
+        }
+    }
+
+    return removeCount == dnf.size();
+}
+
+/* Metoda multiplikacije nad ZDD-om: familija konjunkcija se mnozi
+   instancu po instancu, a konjunkcije sa komplementarnim parom se posle
+   svakog proizvoda uklanjaju iz deljene strukture */
+static bool refuteZDD(const std::vector<Formula> &instances, AtomTable &atoms, const ProverOptions &opts, bool equality)
+{
+    ZddManager zdd;
+    Zdd dnf = ZDD_BASE;
+    for (const Formula &instance : instances) {
+        if (opts.cancelled()) {
+            return false;
+        }
+        dnf = zdd.removeComplementary(zdd.product(dnf, formulaToZdd(instance, atoms, zdd)));
+        if (dnf == ZDD_EMPTY) {
+            return true;
+        }
+    }
+
+    bool refuted = true;
+    for (const Clause &set : zdd.sets(dnf)) {
+        LiteralList conjuncts;
+        for (Lit l : set) {
+            conjuncts.push_back(decodeLiteral(l, atoms));
+        }
+
+        if (equality && !consistentLiterals(conjuncts)) {
+            continue;
+        }
+        refuted = false;
+        if (!opts.verbose) {
+            break;
+        }
+        std::cout << "Conjunctions not removed: [";
+        for (auto literal : conjuncts) {
+            std::cout << literal << ", ";
+        }
+        std::cout << "]" << std::endl;
+    }
+    return refuted;
+}
+
+/* Metoda multiplikacije van radne memorije: konjunkcije se cuvaju u
+   skupu koji se preko budzeta zapisuje na disk, a svaka instanca (cija je
+   DNF mala) se mnozi sa njima u jednom prolazu kroz skup */
+static bool refuteOutOfCore(const std::vector<Formula> &instances, AtomTable &atoms, const ProverOptions &opts, bool equality)
+{
+    std::unique_ptr<ConjunctStore> dnf(new ConjunctStore(opts.memoryBudget, opts.spillDirectory));
+    dnf->add(Clause());
+
+    for (const Formula &instance : instances) {
+        if (opts.cancelled()) {
+            return false;
+        }
+
+        std::vector<Clause> factor;
+        for (const BitConjunct &c : bitDNF(instance, atoms)) {
+            Clause conjunct = encodeLiterals(c.literals(atoms), atoms);
+            sortConjunct(conjunct);
+            factor.push_back(conjunct);
+        }
+
+        std::unique_ptr<ConjunctStore> product(new ConjunctStore(opts.memoryBudget, opts.spillDirectory));
+        Clause merged;
+        dnf->forEach([&](const Lit *c, size_t n) {
+            for (const Clause &d : factor) {
+                if (mergeConjuncts(c, n, d.data(), d.size(), merged)) {
+                    product->add(merged);
                 }
             }
+            return !opts.cancelled();
+        });
+        /* Prekinut prolaz daje samo deo proizvoda */
+        if (opts.cancelled()) {
+            return false;
+        }
+        dnf.swap(product);
+
+        if (dnf->size() == 0) {
+            return true;
+        }
+    }
+
+    if (opts.verbose && dnf->segments() > 0) {
+        std::cout << "Conjunctions on disk: " << dnf->segments() << " segments" << std::endl;
+    }
+
+    bool refuted = true;
+    dnf->forEach([&](const Lit *c, size_t n) {
+        LiteralList conjuncts;
+        for (size_t i = 0; i < n; ++i) {
+            conjuncts.push_back(decodeLiteral(c[i], atoms));
+        }
+
+        if (equality && !consistentLiterals(conjuncts)) {
+            return true;
+        }
+        refuted = false;
+        if (opts.verbose) {
+            std::cout << "Conjunctions not removed: [";
+            for (auto literal : conjuncts) {
+                std::cout << literal << ", ";
+            }
+            std::cout << "]" << std::endl;
+        }
+        return opts.verbose;
+    });
+    return refuted;
+}
+
+/* Instance su klauze definicione KNF, pa se njihova nezadovoljivost
+   proverava DPLL resavacem */
+static bool refuteClausal(Signature &s, const std::vector<Formula> &instances, const ProverOptions &opts)
+{
+    AtomTable atoms;
+    SatSolver solver;
+
+    for (const Formula &instance : instances) {
+        if (opts.cancelled()) {
+            return false;
+        }
+        for (const LiteralList &clause : instance->definitionalCNF(s)) {
+            solver.addClause(encodeLiterals(clause, atoms));
+        }
+    }
+
+    if (!s.hasEquality()) {
+        return !solver.solve();
+    }
+
+    /* Model iskaznog resavaca se proverava kongruentnim zatvorenjem, a
+    nesaglasan skup literala modela se zabranjuje novom klauzom */
+    while (solver.solve()) {
+        if (opts.cancelled()) {
+            return false;
+        }
+
+        LiteralList literals;
+        for (unsigned id = 0; id < atoms.size(); ++id) {
+            const Formula &atom = atoms.atom(id);
+            literals.push_back(solver.modelValue(id) ? atom : std::make_shared<Not>(atom));
+        }
+
+        LiteralList conflict;
+        if (!equalityConflict(literals, conflict)) {
+            return false;
+        }
+
+        Clause blocking;
+        for (const Formula &l : conflict) {
+            blocking.push_back(-encodeLiteral(l, atoms));
+        }
+        solver.addClause(blocking);
+    }
+
+    return true;
+}
+
+/* Konjunkcija instanci dodatih u BDD (sa svih dosadasnjih nivoa) */
+struct BddMatrix {
+    BddManager manager;
+    Bdd matrix = BDD_TRUE;
+    std::set<std::string> conjoined;
+};
+
+/* Instance koje jos nisu u konjunkciji se dodaju u BDD. Svaka instanca (i
+   posle pojednostavljivanja) je posledica osnovnih instanci svog nivoa,
+   pa netacna konjunkcija znaci da je formula nezadovoljiva. Uz jednakost
+   se putevi do lista "tacno" proveravaju kongruentnim zatvorenjem */
+static bool refuteBDD(const std::vector<Formula> &instances, AtomTable &atoms, BddMatrix &bdd,
+                      const ProverOptions &opts, bool equality)
+{
+    for (const Formula &instance : instances) {
+        if (opts.cancelled()) {
+            return false;
+        }
+        if (bdd.conjoined.insert(atomKey(instance)).second) {
+            bdd.matrix = bdd.manager.conjoin(bdd.matrix, formulaToBdd(instance, atoms, bdd.manager));
+        }
+    }
 
-            if (!found) {
-                std::cout << "Conjunctions not removed: [";
-                for (auto literal : conjuncts) {
-                    std::cout << literal << ", ";
+    if (opts.verbose) {
+        std::cout << "BDD nodes: " << bdd.manager.size() << std::endl;
+    }
+
+    if (bdd.matrix == BDD_FALSE) {
+        return true;
+    }
+    if (!equality) {
+        return false;
+    }
+
+    for (const Clause &cube : bdd.manager.cubes(bdd.matrix)) {
+        LiteralList literals;
+        for (Lit l : cube) {
+            literals.push_back(decodeLiteral(l, atoms));
+        }
+        if (opts.cancelled() || consistentLiterals(literals)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool refute(Signature &s, const std::vector<Formula> &instances, AtomTable &atoms, const ProverOptions &opts,
+                   Checkpointer *checkpoint = nullptr)
+{
+    if (opts.clausal) {
+        return refuteClausal(s, instances, opts);
+    }
+    if (opts.zdd) {
+        return refuteZDD(instances, atoms, opts, s.hasEquality());
+    }
+    if (opts.memoryBudget) {
+        return refuteOutOfCore(instances, atoms, opts, s.hasEquality());
+    }
+    return refuteDNF(instances, atoms, opts, s.hasEquality(), checkpoint);
+}
+
+/* Komponente osnovnog problema se pobijaju nezavisno, najvise po jedna u
+   svakoj niti, a prva pobijena komponenta prekida ostale. Svaka nit radi
+   nad svojom kopijom signature, jer definiciona KNF dodaje nove simbole, i
+   svojom kopijom tabele atoma, jer intern nije bezbedan za istovremene
+   pozive (atomComponents je vec dodao sve atome, pa su redni brojevi u
+   kopijama isti) */
+static bool refuteComponents(Signature &s, const std::vector< std::vector<Formula> > &components,
+                             const AtomTable &atoms, const ProverOptions &opts)
+{
+    CancellationToken token(opts.cancellation);
+    ProverOptions local = opts;
+    local.verbose = false;
+    local.cancellation = &token;
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> unsat(false);
+    std::exception_ptr error;
+    std::mutex mutex;
+
+    size_t count = std::max(1u, std::thread::hardware_concurrency());
+    count = std::min(count, components.size());
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < count; ++t) {
+        threads.push_back(std::thread([&]() {
+            CancellationScope scope(&token);
+            Signature sc = s;
+            AtomTable table = atoms;
+            try {
+                for (size_t i = next++; i < components.size() && !token.cancelled(); i = next++) {
+                    if (refute(sc, components[i], table, local)) {
+                        unsat = true;
+                        token.cancel();
+                    }
                 }
-                std::cout << "]" << std::endl;
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+                token.cancel();
             }
+        }));
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    if (error && !unsat) {
+        std::rethrow_exception(error);
+    }
+    return unsat;
+}
+
+/* Zapisuje sertifikat pobijenog nivoa. Tablo se gradi nad instancama pre
+pojednostavljivanja, jer su samo one instance matrice */
+static void writeCertificate(const Signature &s, const Formula &f, const Formula &tf,
+                             const std::vector<InstantiationUnit> &units, const std::set<Term> &level,
+                             const ProverOptions &opts)
+{
+    if (s.hasEquality()) {
+        if (opts.verbose) {
+            std::cout << "Certificate not supported with equality" << std::endl;
         }
+        return;
+    }
 
-        if (removeCount == dnf.size()) {
-            std::cout << "UNSAT" << std::endl;
-            break;
+    Certificate c;
+    c.formula = f;
+    c.miniscope = opts.miniscope;
+    c.clausal = opts.clausal;
+    c.matrix = tf;
+    for (size_t i = 0; i < units.size(); ++i) {
+        for (const Formula &f : groundInstances({units[i]}, level)) {
+            c.instances.push_back(f);
+            c.conjuncts.push_back(opts.perClause ? i : WHOLE_MATRIX);
+        }
+    }
+
+    if (!closeTableau(c)) {
+        throw "Certificate tableau is not closed";
+    }
+    saveCertificate(opts.certificateFile, s, c);
+
+    if (opts.verbose) {
+        std::cout << "Certificate: " << opts.certificateFile << " (" << c.instances.size() << " instances, "
+                  << c.tableau.size() << " tableau words)" << std::endl;
+    }
+}
+
+/* Trazi model skolemizovane matrice sa domenom date velicine */
+static bool searchModel(const Formula &tf, unsigned size, bool verbose)
+{
+    FiniteModel model;
+    if (!findModel(tf, size, model)) {
+        return false;
+    }
+
+    if (verbose) {
+        std::cout << "SAT" << std::endl;
+        std::cout << model;
+    }
+    return true;
+}
+
+static ProofResult gilmoreLevels(Signature &s, const Formula &f, const ProverOptions &opts)
+{
+    Checkpointer checkpoint(s, opts);
+    bool resumed = opts.resume && checkpoint.enabled() && checkpoint.matches(f) &&
+                   loadCheckpoint(opts.checkpointFile, s, checkpoint.state);
+
+    Formula tf;
+    if (resumed) {
+        tf = checkpoint.state.matrix;
+    } else {
+        tf = skolemMatrix(s, f, opts);
+        if (opts.clausal) {
+            tf = clausesToFormula(tf->definitionalCNF(s));
+        }
+        checkpoint.state.formula = f;
+        checkpoint.state.miniscope = opts.miniscope;
+        checkpoint.state.clausal = opts.clausal;
+        checkpoint.state.matrix = tf;
+    }
+
+    HerbrandUniverse universe(s, tf, opts.verbose && !resumed);
+    std::vector<InstantiationUnit> units = instantiationUnits(tf, opts);
+    AtomTable atoms;
+    BddMatrix bdd;
+
+    if (resumed) {
+        universe.restoreLevel(checkpoint.state.level);
+        for (const Formula &atom : checkpoint.state.atoms) {
+            atoms.intern(atom);
+        }
+        if (opts.verbose) {
+            std::cout << "Resuming from checkpoint, iteration " << checkpoint.state.iteration << std::endl;
+        }
+    }
+
+    size_t iteration;
+    for (iteration = checkpoint.state.iteration; iteration < MAX_ITERATIONS; ++iteration) {
+        if (opts.cancelled()) {
+            return PR_UNKNOWN;
+        }
+
+        /* Kontrolna tacka zapisana usred nivoa mora sadrzati i njegove termove */
+        checkpoint.state.iteration = iteration;
+        checkpoint.state.level = universe.level();
+
+        bool unsat = false;
+        if (!checkpoint.state.instances.empty()) {
+            /* Nastavak nivoa prekinutog usred multiplikacije; instance su
+            vec pojednostavljene */
+            unsat = refuteDNF(checkpoint.state.instances, atoms, opts, s.hasEquality(), &checkpoint);
         } else {
+            std::vector<Formula> instances = groundInstances(units, universe.level());
+
+            if (opts.simplifyGround && !simplifyInstances(instances, s.hasEquality())) {
+                unsat = true;
+            } else if (opts.bdd) {
+                unsat = refuteBDD(instances, atoms, bdd, opts, s.hasEquality());
+            } else if (!instances.empty()) {
+                std::vector< std::vector<Formula> > components;
+                if (opts.splitComponents && !s.hasEquality()) {
+                    components = atomComponents(instances, atoms);
+                }
+                unsat = components.size() > 1 ? refuteComponents(s, components, atoms, opts)
+                                              : refute(s, instances, atoms, opts, &checkpoint);
+            }
+        }
+
+        if (unsat) {
+            if (opts.verbose) {
+                std::cout << "UNSAT" << std::endl;
+            }
+            if (!opts.certificateFile.empty()) {
+                writeCertificate(s, f, tf, units, universe.level(), opts);
+            }
+            return PR_UNSAT;
+        }
+
+        /* U svakoj iteraciji se trazi i model za jedan element veceg domena */
+        if (opts.modelSearch && iteration < opts.maxModelSize &&
+                searchModel(tf, iteration + 1, opts.verbose)) {
+            return PR_SAT;
+        }
+
+        if (opts.verbose) {
             std::cout << "Next level..." << std::endl;
         }
 
         universe.nextLevel();
+
+        checkpoint.state.iteration = iteration + 1;
+        checkpoint.state.level = universe.level();
+        checkpoint.state.instances.clear();
+        checkpoint.state.processed = 0;
+        checkpoint.state.conjuncts.clear();
+        if (checkpoint.enabled()) {
+            checkpoint.save(atoms);
+        }
+    }
+
+    if (opts.modelSearch) {
+        for (unsigned size = iteration + 1; size <= opts.maxModelSize && !opts.cancelled(); ++size) {
+            if (searchModel(tf, size, opts.verbose)) {
+                return PR_SAT;
+            }
+        }
+    }
+
+    return PR_UNKNOWN;
+}
+
+ProofResult gilmore(Signature s, const Formula &f, const ProverOptions &opts)
+{
+    CancellationScope scope(opts.cancellation);
+    try {
+        return gilmoreLevels(s, f, opts);
+    } catch (const ProofCancelled &) {
+        return PR_UNKNOWN;
     }
 }
 
@@ -106,6 +744,7 @@ std::vector< std::vector<Term> > product(std::set<Term> s, int repeat)
 
 void variations(size_t pos, std::vector<Term> currPerm, std::set<Term> items, std::vector< std::vector<Term> >& res)
 {
+    throwIfCancelled();
     if (pos == currPerm.size()) {
         res.push_back(currPerm);
     } else {
@@ -4,12 +4,138 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <future>
 
 #include "first_order_logic.h"
+#include "cancellation.h"
 
-void gilmore(Signature s, const Formula &f);
+/* Dokazivac koji koristi funkcija prove: Gilmorova procedura, rezolucija
+(videti resolution.h), instanciranje vodjeno modelom (videti instgen.h)
+ili konekcioni tablo (videti connection.h). S_PORTFOLIO pokrece vise
+strategija u posebnim nitima (videti portfolio.h) */
+enum ProverStrategy { S_GILMORE, S_RESOLUTION, S_INSTGEN, S_CONNECTION, S_PORTFOLIO };
 
-void prove(Signature s, const Formula &f);
+/* Podesavanja Gilmorove procedure */
+struct ProverOptions {
+    ProverStrategy strategy = S_GILMORE;
+
+    /* Da li se pre skolemizacije kvantifikatori spustaju sto dublje u
+    formulu (miniscoping), umesto svodjenja na PRENEX */
+    bool miniscope = false;
+
+    /* Da li se matrica deli na konjunkte koji se instanciraju nezavisno,
+    svaki samo po svojim varijablama, umesto instanciranja cele matrice */
+    bool perClause = false;
+
+    /* Da li se matrica svodi na definicionu KNF, a nezadovoljivost osnovnih
+    instanci proverava DPLL resavacem umesto multiplikacijom DNF-a */
+    bool clausal = false;
+
+    /* Da li se familija konjunkcija DNF-a u metodi multiplikacije gradi i
+    filtrira kao ZDD (videti zdd.h), umesto konjunkciju po konjunkciju */
+    bool zdd = false;
+
+    /* Ako nije nula, konjunkcije DNF-a u metodi multiplikacije se cuvaju u
+    skupu ciji se deo preko ovog broja bajtova zapisuje na disk, u
+    direktorijum spillDirectory (videti conjunct_store.h), a multiplikacija
+    i provera komplementarnih parova se rade prolazima kroz taj skup */
+    size_t memoryBudget = 0;
+    std::string spillDirectory = "/tmp";
+
+    /* Da li se nezadovoljivost osnovnih instanci proverava BDD-om (videti
+    bdd.h) u koji se instance dodaju inkrementalno, nivo po nivo, umesto
+    multiplikacijom DNF-a ili DPLL resavacem */
+    bool bdd = false;
+
+    /* Da li se osnovne instance pre provere pojednostavljuju propagacijom
+    jedinicnih i eliminacijom cistih literala (videti ground.h) */
+    bool simplifyGround = false;
+
+    /* Da li se osnovni problem deli na komponente bez zajednickih atoma
+    koje se pobijaju nezavisno, u zasebnim nitima (videti ground.h); ne
+    primenjuje se uz jednakost, jer kongruencija povezuje atome sa
+    zajednickim termovima */
+    bool splitComponents = false;
+
+    /* Da li se uporedo sa Gilmorovom procedurom traze i konacni modeli
+    (kontramodeli polazne formule), sa domenima velicine 1..maxModelSize */
+    bool modelSearch = false;
+    unsigned maxModelSize = 4;
+
+    /* Da li rezolucija koristi skup potpore: ako je formula implikacija,
+    klauze pretpostavki se medjusobno ne razresavaju */
+    bool setOfSupport = true;
+
+    /* Najveci broj zadrzanih klauza pre nego sto rezolucija (odnosno
+    Inst-Gen) odustane */
+    unsigned maxClauses = 20000;
+
+    /* Najveca duzina puta do koje konekcioni dokazivac produbljuje
+    pretragu */
+    unsigned maxDepth = 12;
+
+    /* Ako je zadata, Gilmorova procedura na kraju svakog nivoa, kao i usred
+    multiplikacije najvise na svakih checkpointInterval sekundi, zapisuje
+    svoje stanje u ovu datoteku (videti checkpoint.h). Uz resume se
+    dokazivanje nastavlja iz postojece kontrolne tacke. Usred nivoa se stanje
+    zapisuje samo u osnovnoj metodi multiplikacije (bez clausal, zdd,
+    memoryBudget, bdd i splitComponents); ostale provere nivoa se posle
+    nastavka ponavljaju od pocetka nivoa */
+    std::string checkpointFile;
+    unsigned checkpointInterval = 600;
+    bool resume = false;
+
+    /* Ako je zadata, Gilmorova procedura po pobijanju nivoa u ovu datoteku
+    zapisuje sertifikat: osnovne instance matrice i zatvoren tablo nad
+    njima, koji proverava nezavisni program checker (videti
+    certificate.h). Ne zapisuje se uz jednakost */
+    std::string certificateFile;
+
+    /* Da li se ispisuju ishod i tok dokazivanja */
+    bool verbose = true;
+
+    /* Zahtev za prekid (ako je zadat); prekinut dokazivac vraca
+    PR_UNKNOWN */
+    const CancellationToken *cancellation = nullptr;
+
+    bool cancelled() const { return cancellation && cancellation->cancelled(); }
+};
+
+/* Ishod dokazivanja: negirana formula je nezadovoljiva (polazna formula je
+valjana), zadovoljiva (nadjen je kontramodel) ili ishod nije poznat */
+enum ProofResult { PR_UNSAT, PR_SAT, PR_UNKNOWN };
+
+/* Deo matrice koji se instancira termovima Erbranovog univerzuma */
+struct InstantiationUnit {
+    Formula matrix;
+    std::vector<Variable> variables;
+};
+
+ProofResult gilmore(Signature s, const Formula &f, const ProverOptions &opts = ProverOptions());
+
+ProofResult prove(Signature s, const Formula &f, const ProverOptions &opts = ProverOptions());
+
+/* Pokrece prove u novoj niti i odmah vraca buducu vrednost ishoda. Ako je
+   zadat, token zamenjuje opts.cancellation; prekid se proverava i unutar
+   prelaska na sledeci nivo, generisanja n-torki, supstitucije i
+   multiplikacije, pa prekinuto dokazivanje brzo vraca PR_UNKNOWN. Token i
+   signatura na koju se vezuju termovi formule moraju postojati dok se
+   dokazivanje ne zavrsi */
+std::future<ProofResult> proveAsync(const Signature &s, const Formula &f, const ProverOptions &opts = ProverOptions(),
+                                    const CancellationToken *token = nullptr);
+
+/* Eliminise kvantifikatore iz formule (NNF, PRENEX ili miniscoping, pa
+skolemizacija) i vraca bazu formule bez univerzalnih kvantifikatora */
+Formula skolemMatrix(Signature &s, const Formula &f, const ProverOptions &opts);
+
+/* Od liste klauza gradi formulu (konjunkciju disjunkcija) */
+Formula clausesToFormula(const LiteralListList &clauses);
+
+/* Deli matricu na delove koji se nezavisno instanciraju */
+std::vector<InstantiationUnit> instantiationUnits(const Formula &tf, const ProverOptions &opts);
+
+/* Vraca sve osnovne instance datih delova matrice nad termovima level */
+std::vector<Formula> groundInstances(const std::vector<InstantiationUnit> &units, const std::set<Term> &level);
 
 
 std::vector< std::vector<Term> > product(std::set<Term> s, int repeat = 2);
@@ -0,0 +1,441 @@
+#include "ground.h"
+
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+std::string atomKey(const Formula &atom)
+{
+    std::ostringstream ss;
+    ss << atom;
+    return ss.str();
+}
+
+static size_t combineHash(size_t h, size_t v)
+{
+    return h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+static size_t termHash(const Term &t)
+{
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        return std::hash<std::string>()(((VariableTerm*)t.get())->getVariable());
+    }
+
+    FunctionTerm *f = (FunctionTerm*)t.get();
+    size_t h = std::hash<std::string>()(f->getSymbol());
+    for (const Term &op : f->getOperands()) {
+        h = combineHash(h, termHash(op));
+    }
+    return h;
+}
+
+/* Strukturni hes atoma; ostale formule se hesiraju po tekstualnom zapisu */
+static size_t atomHash(const Formula &atom)
+{
+    if (atom->getType() != BaseFormula::T_ATOM) {
+        return std::hash<std::string>()(atomKey(atom));
+    }
+
+    Atom *a = (Atom*)atom.get();
+    size_t h = std::hash<std::string>()(a->getSymbol());
+    for (const Term &op : a->getOperands()) {
+        h = combineHash(h, termHash(op));
+    }
+    return h;
+}
+
+unsigned AtomTable::intern(const Formula &atom)
+{
+    std::vector<unsigned> &bucket = m_ids[atomHash(atom)];
+    for (unsigned id : bucket) {
+        if (m_atoms[id]->equalTo(atom)) {
+            return id;
+        }
+    }
+
+    unsigned id = m_atoms.size();
+    bucket.push_back(id);
+    m_atoms.push_back(atom);
+    return id;
+}
+
+bool AtomTable::find(const Formula &atom, unsigned &id) const
+{
+    auto it = m_ids.find(atomHash(atom));
+    if (it == m_ids.end()) {
+        return false;
+    }
+    for (unsigned i : it->second) {
+        if (m_atoms[i]->equalTo(atom)) {
+            id = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const Formula &AtomTable::atom(unsigned id) const
+{
+    return m_atoms.at(id);
+}
+
+size_t AtomTable::size() const
+{
+    return m_atoms.size();
+}
+
+Lit encodeLiteral(const Formula &literal, AtomTable &table)
+{
+    if (literal->getType() == BaseFormula::T_NOT) {
+        return -(Lit)(table.intern(((Not*)literal.get())->getOperand()) + 1);
+    } else if (literal->getType() == BaseFormula::T_ATOM) {
+        return table.intern(literal) + 1;
+    } else {
+        throw "Bad type";
+    }
+}
+
+Clause encodeLiterals(const LiteralList &literals, AtomTable &table)
+{
+    Clause c;
+    for (const Formula &l : literals) {
+        c.push_back(encodeLiteral(l, table));
+    }
+    return c;
+}
+
+Formula decodeLiteral(Lit l, const AtomTable &table)
+{
+    if (l < 0) {
+        return std::make_shared<Not>(table.atom(-l - 1));
+    }
+    return table.atom(l - 1);
+}
+
+void BitConjunct::add(Lit l)
+{
+    std::vector<uint64_t> &bits = l > 0 ? pos : neg;
+    unsigned id = std::abs(l) - 1;
+    if (id / 64 >= bits.size()) {
+        bits.resize(id / 64 + 1, 0);
+    }
+    bits[id / 64] |= (uint64_t)1 << (id % 64);
+}
+
+bool BitConjunct::closed() const
+{
+    size_t n = std::min(pos.size(), neg.size());
+    for (size_t i = 0; i < n; ++i) {
+        if (pos[i] & neg[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void unite(std::vector<uint64_t> &res, const std::vector<uint64_t> &a, const std::vector<uint64_t> &b)
+{
+    const std::vector<uint64_t> &longer = a.size() >= b.size() ? a : b;
+    const std::vector<uint64_t> &shorter = a.size() >= b.size() ? b : a;
+    res = longer;
+    for (size_t i = 0; i < shorter.size(); ++i) {
+        res[i] |= shorter[i];
+    }
+}
+
+BitConjunct BitConjunct::merge(const BitConjunct &c) const
+{
+    BitConjunct res;
+    unite(res.pos, pos, c.pos);
+    unite(res.neg, neg, c.neg);
+    return res;
+}
+
+LiteralList BitConjunct::literals(const AtomTable &table) const
+{
+    LiteralList res;
+    for (size_t i = 0; i < pos.size() * 64; ++i) {
+        if (pos[i / 64] >> (i % 64) & 1) {
+            res.push_back(table.atom(i));
+        }
+    }
+    for (size_t i = 0; i < neg.size() * 64; ++i) {
+        if (neg[i / 64] >> (i % 64) & 1) {
+            res.push_back(std::make_shared<Not>(table.atom(i)));
+        }
+    }
+    return res;
+}
+
+Clause BitConjunct::encoded() const
+{
+    Clause res;
+    for (size_t i = 0; i < pos.size() * 64; ++i) {
+        if (pos[i / 64] >> (i % 64) & 1) {
+            res.push_back(i + 1);
+        }
+    }
+    for (size_t i = 0; i < neg.size() * 64; ++i) {
+        if (neg[i / 64] >> (i % 64) & 1) {
+            res.push_back(-(Lit)(i + 1));
+        }
+    }
+    return res;
+}
+
+std::vector<BitConjunct> multiplyDNF(const std::vector<BitConjunct> &d1, const std::vector<BitConjunct> &d2)
+{
+    std::vector<BitConjunct> res;
+    for (const BitConjunct &c1 : d1) {
+        throwIfCancelled();
+        for (const BitConjunct &c2 : d2) {
+            BitConjunct c = c1.merge(c2);
+            if (!c.closed()) {
+                res.push_back(c);
+            }
+        }
+    }
+    return res;
+}
+
+std::vector<BitConjunct> bitDNF(const Formula &f, AtomTable &table)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+        return std::vector<BitConjunct>(1);
+    case BaseFormula::T_FALSE:
+        return std::vector<BitConjunct>();
+    case BaseFormula::T_ATOM:
+    case BaseFormula::T_NOT: {
+        BitConjunct c;
+        c.add(encodeLiteral(f, table));
+        return std::vector<BitConjunct>{ c };
+    }
+    case BaseFormula::T_AND:
+        return multiplyDNF(bitDNF(((And*)f.get())->getOperand1(), table),
+                           bitDNF(((And*)f.get())->getOperand2(), table));
+    case BaseFormula::T_OR: {
+        std::vector<BitConjunct> res = bitDNF(((Or*)f.get())->getOperand1(), table);
+        std::vector<BitConjunct> d2 = bitDNF(((Or*)f.get())->getOperand2(), table);
+        res.insert(res.end(), d2.begin(), d2.end());
+        return res;
+    }
+    default:
+        throw "Bad type";
+    }
+}
+
+/* Zamenjuje atome kojima je dodeljena vrednost logickim konstantama */
+static Formula assignAtoms(const Formula &f, AtomTable &atoms, std::vector<signed char> &value)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        return f;
+    case BaseFormula::T_ATOM: {
+        unsigned id = atoms.intern(f);
+        if (id >= value.size()) {
+            value.resize(id + 1, -1);
+        }
+        if (value[id] < 0) {
+            return f;
+        }
+        return value[id] ? (Formula)std::make_shared<True>() : (Formula)std::make_shared<False>();
+    }
+    case BaseFormula::T_NOT: {
+        Formula op = ((Not*)f.get())->getOperand();
+        Formula res = assignAtoms(op, atoms, value);
+        return res == op ? f : std::make_shared<Not>(res);
+    }
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR: {
+        BinaryConnective *b = (BinaryConnective*)f.get();
+        Formula op1 = assignAtoms(b->getOperand1(), atoms, value);
+        Formula op2 = assignAtoms(b->getOperand2(), atoms, value);
+        if (op1 == b->getOperand1() && op2 == b->getOperand2()) {
+            return f;
+        }
+        if (f->getType() == BaseFormula::T_AND) {
+            return std::make_shared<And>(op1, op2);
+        }
+        return std::make_shared<Or>(op1, op2);
+    }
+    default:
+        throw "Bad type";
+    }
+}
+
+/* Jedinicni literali instance: literali na vrhu konjunkcije */
+static void collectUnits(const Formula &f, LiteralList &units)
+{
+    if (f->getType() == BaseFormula::T_AND) {
+        collectUnits(((And*)f.get())->getOperand1(), units);
+        collectUnits(((And*)f.get())->getOperand2(), units);
+    } else if (f->getType() == BaseFormula::T_ATOM || f->getType() == BaseFormula::T_NOT) {
+        units.push_back(f);
+    }
+}
+
+/* Znakovi sa kojima se atomi javljaju: bit 1 pozitivno, bit 2 negativno */
+static void collectPolarity(const Formula &f, AtomTable &atoms, std::vector<unsigned char> &polarity)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_ATOM:
+    case BaseFormula::T_NOT: {
+        bool positive = f->getType() == BaseFormula::T_ATOM;
+        unsigned id = atoms.intern(positive ? f : ((Not*)f.get())->getOperand());
+        if (id >= polarity.size()) {
+            polarity.resize(id + 1, 0);
+        }
+        polarity[id] |= positive ? 1 : 2;
+        break;
+    }
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+        collectPolarity(((BinaryConnective*)f.get())->getOperand1(), atoms, polarity);
+        collectPolarity(((BinaryConnective*)f.get())->getOperand2(), atoms, polarity);
+        break;
+    default:
+        break;
+    }
+}
+
+bool simplifyInstances(std::vector<Formula> &instances, bool equality)
+{
+    AtomTable atoms;
+    std::vector<signed char> value;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        /* Propagacija jedinicnih literala */
+        std::vector<Formula> remaining;
+        for (const Formula &instance : instances) {
+            Formula f = assignAtoms(instance, atoms, value)->simplify();
+            if (f->getType() == BaseFormula::T_FALSE) {
+                return false;
+            }
+            if (f->getType() == BaseFormula::T_TRUE) {
+                continue;
+            }
+
+            LiteralList units;
+            collectUnits(f, units);
+            for (const Formula &l : units) {
+                bool positive = l->getType() == BaseFormula::T_ATOM;
+                unsigned id = atoms.intern(positive ? l : ((Not*)l.get())->getOperand());
+                if (id >= value.size()) {
+                    value.resize(id + 1, -1);
+                }
+                if (value[id] == !positive) {
+                    return false;
+                }
+                if (value[id] < 0) {
+                    value[id] = positive;
+                    changed = true;
+                }
+            }
+            remaining.push_back(f);
+        }
+        instances.swap(remaining);
+
+        if (changed || equality) {
+            continue;
+        }
+
+        /* Eliminacija cistih literala. Instance sa cistim literalom se
+        izbacuju, a ostale ne sadrze njegov atom, pa se ne menjaju */
+        std::vector<unsigned char> polarity;
+        for (const Formula &instance : instances) {
+            collectPolarity(instance, atoms, polarity);
+        }
+
+        for (unsigned id = 0; id < polarity.size(); ++id) {
+            if ((polarity[id] == 1 || polarity[id] == 2) && (id >= value.size() || value[id] < 0)) {
+                if (id >= value.size()) {
+                    value.resize(id + 1, -1);
+                }
+                value[id] = polarity[id] == 1;
+                changed = true;
+            }
+        }
+    }
+
+    if (equality) {
+        for (unsigned id = 0; id < value.size(); ++id) {
+            if (value[id] >= 0) {
+                instances.push_back(value[id] ? atoms.atom(id) : std::make_shared<Not>(atoms.atom(id)));
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Redni brojevi atoma instance */
+static void collectAtoms(const Formula &f, AtomTable &atoms, std::vector<unsigned> &ids)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_ATOM:
+        ids.push_back(atoms.intern(f));
+        break;
+    case BaseFormula::T_NOT:
+        collectAtoms(((Not*)f.get())->getOperand(), atoms, ids);
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+        collectAtoms(((BinaryConnective*)f.get())->getOperand1(), atoms, ids);
+        collectAtoms(((BinaryConnective*)f.get())->getOperand2(), atoms, ids);
+        break;
+    default:
+        break;
+    }
+}
+
+static unsigned findRoot(std::vector<unsigned> &parent, unsigned n)
+{
+    while (parent[n] != n) {
+        parent[n] = parent[parent[n]];
+        n = parent[n];
+    }
+    return n;
+}
+
+std::vector< std::vector<Formula> > atomComponents(const std::vector<Formula> &instances, AtomTable &table)
+{
+    std::vector< std::vector<unsigned> > ids(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i) {
+        collectAtoms(instances[i], table, ids[i]);
+    }
+
+    std::vector<unsigned> parent(table.size());
+    for (unsigned id = 0; id < parent.size(); ++id) {
+        parent[id] = id;
+    }
+    for (const std::vector<unsigned> &atoms : ids) {
+        for (size_t j = 1; j < atoms.size(); ++j) {
+            parent[findRoot(parent, atoms[j])] = findRoot(parent, atoms[0]);
+        }
+    }
+
+    /* Instanca bez atoma (konstanta) je sama svoja komponenta */
+    std::vector< std::vector<Formula> > components;
+    std::map<unsigned, size_t> index;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        if (ids[i].empty()) {
+            components.push_back(std::vector<Formula>{ instances[i] });
+            continue;
+        }
+
+        unsigned root = findRoot(parent, ids[i][0]);
+        auto it = index.find(root);
+        if (it == index.end()) {
+            it = index.insert(std::make_pair(root, components.size())).first;
+            components.push_back(std::vector<Formula>());
+        }
+        components[it->second].push_back(instances[i]);
+    }
+    return components;
+}
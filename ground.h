@@ -0,0 +1,98 @@
+#ifndef GROUND_H
+#define GROUND_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+
+#include "first_order_logic.h"
+
+/* Literal nad tabelom atoma se predstavlja celim brojem: +(id + 1) za atom
+   sa rednim brojem id, odnosno -(id + 1) za njegovu negaciju */
+typedef int Lit;
+typedef std::vector<Lit> Clause;
+typedef std::vector<Clause> ClauseSet;
+
+/* Tabela (osnovnih) atoma. Svaki atom dobija jedinstven redni broj, pa se
+   atomi dalje porede kao celi brojevi, a ne obilaskom stabla. Atomi se
+   traze po strukturnom hesu (simboli i podtermovi), a atomi sa istim hesom
+   se porede sa equalTo, bez pravljenja tekstualnog zapisa */
+class AtomTable {
+    std::unordered_map<size_t, std::vector<unsigned> > m_ids;
+    std::vector<Formula> m_atoms;
+public:
+    /* Vraca redni broj atoma, dodajuci ga u tabelu ako ranije nije postojao */
+    unsigned intern(const Formula &atom);
+
+    /* Vraca redni broj atoma ako postoji u tabeli */
+    bool find(const Formula &atom, unsigned &id) const;
+
+    const Formula &atom(unsigned id) const;
+    size_t size() const;
+};
+
+/* Kljuc atoma (ili terma) u tabeli je njegov tekstualni zapis */
+std::string atomKey(const Formula &atom);
+
+/* Prevodi literal (atom ili negaciju atoma) u celobrojni zapis */
+Lit encodeLiteral(const Formula &literal, AtomTable &table);
+
+/* Prevodi listu literala u celobrojni zapis */
+Clause encodeLiterals(const LiteralList &literals, AtomTable &table);
+
+/* Vraca literal koji odgovara celobrojnom zapisu */
+Formula decodeLiteral(Lit l, const AtomTable &table);
+
+/* Konjunkcija osnovnih literala kao par skupova bitova: i-ti bit skupa pos
+   (odnosno neg) je postavljen ako konjunkcija sadrzi atom sa rednim brojem
+   i (odnosno njegovu negaciju). Provera komplementarnog para se svodi na
+   presek skupova, a spajanje konjunkcija na uniju */
+struct BitConjunct {
+    std::vector<uint64_t> pos;
+    std::vector<uint64_t> neg;
+
+    /* Dodaje literal u celobrojnom zapisu */
+    void add(Lit l);
+
+    /* Da li konjunkcija sadrzi komplementaran par literala */
+    bool closed() const;
+
+    /* Unija dve konjunkcije */
+    BitConjunct merge(const BitConjunct &c) const;
+
+    /* Literali konjunkcije */
+    LiteralList literals(const AtomTable &table) const;
+
+    /* Literali konjunkcije u celobrojnom zapisu */
+    Clause encoded() const;
+};
+
+/* DNF osnovne formule u NNF-u nad tabelom atoma, bez zatvorenih
+   konjunkcija (one se odbacuju vec tokom multiplikacije) */
+std::vector<BitConjunct> bitDNF(const Formula &f, AtomTable &table);
+
+/* Proizvod dve DNF (sve unije parova konjunkcija), bez zatvorenih */
+std::vector<BitConjunct> multiplyDNF(const std::vector<BitConjunct> &d1, const std::vector<BitConjunct> &d2);
+
+/* Deli skup osnovnih instanci na komponente povezanosti grafa u kome su
+   dve instance susedne ako imaju zajednicki atom (union-find nad rednim
+   brojevima atoma). Svi atomi instanci se pritom upisuju u tabelu. Skup
+   instanci je nezadovoljiv ako i samo ako je neka komponenta
+   nezadovoljiva, jer komponente nemaju zajednickih atoma */
+std::vector< std::vector<Formula> > atomComponents(const std::vector<Formula> &instances, AtomTable &table);
+
+/* Pojednostavljuje skup osnovnih instanci (formula u NNF-u) do fiksne
+   tacke: jedinicni literali se propagiraju (zadovoljene instance se
+   izbacuju, a netacni literali brisu), a atomi koji se javljaju samo sa
+   jednim znakom (cisti literali) se postavljaju tako da budu tacni.
+   Ako signatura ima jednakost, sintaksno razliciti atomi mogu biti jednaki
+   po kongruenciji, pa se cisti literali ne eliminisu, a propagirani
+   jedinicni literali se zadrzavaju kao jedinicne instance (potrebni su
+   kongruentnom zatvorenju). Preostale instance su uvek posledice polaznih,
+   pa se mogu dodavati u konjunkciju koja se cuva kroz nivoe. Vraca false
+   ako je skup instanci nezadovoljiv */
+bool simplifyInstances(std::vector<Formula> &instances, bool equality);
+
+#endif
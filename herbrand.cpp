@@ -5,7 +5,7 @@
 #include <iterator>
 #include <iostream>
 
-HerbrandUniverse::HerbrandUniverse(const Signature & sig,const Formula & f)
+HerbrandUniverse::HerbrandUniverse(const Signature & sig,const Formula & f, bool verbose)
     : m_signature(sig), m_formula(f)
 {
     m_formula->getFunctions(m_functions);
@@ -17,7 +17,9 @@ HerbrandUniverse::HerbrandUniverse(const Signature & sig,const Formula & f)
         m_level.insert(t);
     }
     if (m_level.size() == 0) {
-        std::cout << "No constants found, inserting unique..." << std::endl;
+        if (verbose) {
+            std::cout << "No constants found, inserting unique..." << std::endl;
+        }
         m_level.insert(
             std::make_shared<FunctionTerm>(m_signature, m_signature.getNewUniqueConstant(), std::vector<Term>{})
         );
@@ -39,6 +41,7 @@ void HerbrandUniverse::nextLevel()
         m_signature.checkFunctionSymbol(*i, arity);
 
         do {
+            throwIfCancelled();
             std::vector<Term> operands;
             if (arity > tmp.size()) {
                 operands = std::vector<Term>(tmp.begin(), tmp.end());
@@ -68,6 +71,11 @@ void HerbrandUniverse::nextLevel()
     }
 }
 
+void HerbrandUniverse::restoreLevel(const std::set<Term> & level)
+{
+    m_level = level;
+}
+
 ostream & operator << (ostream & out, const HerbrandUniverse & hu) {
     out << "Functions:" << endl;
     out << "{ ";
@@ -12,9 +12,11 @@ class HerbrandUniverse {
     FunctionSet m_functions;
     std::set<Term> m_level;
 public:
-    HerbrandUniverse(const Signature & sig, const Formula & f);
+    HerbrandUniverse(const Signature & sig, const Formula & f, bool verbose = true);
     std::set<Term> level() const;
     void nextLevel();
+    /* Postavlja tekuci nivo (npr. procitan iz kontrolne tacke) */
+    void restoreLevel(const std::set<Term> & level);
     friend ostream & operator << (ostream & out, const HerbrandUniverse & hu);
 };
 
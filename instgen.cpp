@@ -0,0 +1,180 @@
+#include "instgen.h"
+#include "unification.h"
+#include "ground.h"
+#include "sat.h"
+
+#include <set>
+
+class InstGen {
+    Term m_bottom;
+
+    /* Klauze, standardizovane funkcijom renameClause */
+    LiteralListList m_clauses;
+    std::set<std::string> m_keys;
+
+    /* Osnovne apstrakcije klauza i resavac nad njima */
+    std::vector<Clause> m_ground;
+    AtomTable m_atoms;
+    SatSolver m_solver;
+
+    const ProverOptions &m_opts;
+
+    Formula abstraction(const Formula &literal) const;
+    bool selected(Lit l) const;
+
+public:
+    InstGen(Signature &s, const ProverOptions &opts);
+
+    /* Dodaje klauzu ako nije varijanta neke vec dodate */
+    bool addClause(const LiteralList &literals);
+
+    ProofResult run();
+};
+
+static Formula complement(const Formula &l)
+{
+    if (l->getType() == BaseFormula::T_NOT) {
+        return ((Not*)l.get())->getOperand();
+    }
+    return std::make_shared<Not>(l);
+}
+
+InstGen::InstGen(Signature &s, const ProverOptions &opts)
+    : m_opts(opts)
+{
+    /* Konstanta kojom se u apstrakciji zamenjuju sve varijable */
+    FunctionSymbol bottom = getUniqueFunctionSymbol(s);
+    s.addFunctionSymbol(bottom, 0);
+    m_bottom = std::make_shared<FunctionTerm>(s, bottom);
+}
+
+Formula InstGen::abstraction(const Formula &literal) const
+{
+    VariableSet vars;
+    literal->getVars(vars);
+
+    Substitution s;
+    for (const Variable &v : vars) {
+        s[v] = m_bottom;
+    }
+    return applySubstitution(literal, s);
+}
+
+/* Vrednost literala apstrakcije u modelu resavaca */
+bool InstGen::selected(Lit l) const
+{
+    bool value = m_solver.modelValue(std::abs(l) - 1);
+    return l > 0 ? value : !value;
+}
+
+bool InstGen::addClause(const LiteralList &literals)
+{
+    LiteralList clause = renameClause(literals, "X");
+
+    std::string key;
+    for (const Formula &l : clause) {
+        key += atomKey(l) + ";";
+    }
+    if (!m_keys.insert(key).second) {
+        return false;
+    }
+
+    Clause ground;
+    for (const Formula &l : clause) {
+        ground.push_back(encodeLiteral(abstraction(l), m_atoms));
+    }
+
+    m_clauses.push_back(clause);
+    m_ground.push_back(ground);
+    m_solver.addClause(ground);
+    return true;
+}
+
+ProofResult InstGen::run()
+{
+    while (m_clauses.size() <= m_opts.maxClauses && !m_opts.cancelled()) {
+        if (!m_solver.solve()) {
+            return PR_UNSAT;
+        }
+
+        /* Iz svake klauze se bira prvi literal tacan u modelu apstrakcije */
+        std::vector< std::pair<unsigned, unsigned> > selection;
+        DiscriminationTree index;
+        for (unsigned c = 0; c < m_clauses.size(); ++c) {
+            for (unsigned i = 0; i < m_ground[c].size(); ++i) {
+                if (selected(m_ground[c][i])) {
+                    index.insert(m_clauses[c][i], selection.size());
+                    selection.push_back(std::make_pair(c, i));
+                    break;
+                }
+            }
+        }
+
+        /* Instance koje razresavaju konflikte izabranih literala */
+        LiteralListList instances;
+        for (unsigned k = 0; k < selection.size(); ++k) {
+            const LiteralList &c1 = m_clauses[selection[k].first];
+            LiteralList renamed = renameClause(c1, "Y");
+            Formula comp = complement(renamed[selection[k].second]);
+
+            for (unsigned m : index.unifiable(comp)) {
+                if (m < k) {
+                    continue;
+                }
+
+                const LiteralList &c2 = m_clauses[selection[m].first];
+                Substitution s;
+                if (!unify(comp, c2[selection[m].second], s)) {
+                    continue;
+                }
+
+                LiteralList i1, i2;
+                for (const Formula &l : renamed) {
+                    i1.push_back(applySubstitution(l, s));
+                }
+                for (const Formula &l : c2) {
+                    i2.push_back(applySubstitution(l, s));
+                }
+                instances.push_back(i1);
+                instances.push_back(i2);
+            }
+        }
+
+        bool added = false;
+        for (const LiteralList &instance : instances) {
+            added = addClause(instance) || added;
+        }
+
+        if (!added) {
+            return PR_SAT;
+        }
+    }
+
+    return PR_UNKNOWN;
+}
+
+ProofResult instGen(Signature s, const Formula &f, const ProverOptions &opts)
+{
+    InstGen prover(s, opts);
+
+    for (const LiteralList &clause : skolemMatrix(s, f, opts)->definitionalCNF(s)) {
+        prover.addClause(clause);
+    }
+
+    ProofResult res = prover.run();
+
+    /* Jednakost je ovde obican predikat, pa je zadovoljivost pouzdana samo
+    bez nje */
+    if (res == PR_SAT && s.hasEquality()) {
+        res = PR_UNKNOWN;
+    }
+    if (!opts.verbose) {
+        return res;
+    }
+    if (res == PR_UNSAT) {
+        std::cout << "UNSAT" << std::endl;
+    } else if (res == PR_SAT) {
+        std::cout << "SAT" << std::endl;
+    }
+    return res;
+}
@@ -0,0 +1,22 @@
+#ifndef INSTGEN_H
+#define INSTGEN_H
+
+#include "first_order_logic.h"
+#include "gilmore.h"
+
+/* Instanciranje vodjeno modelom (Inst-Gen). Formula se priprema kao kod
+   Gilmorove procedure i svodi na klauze definicionom KNF. U svakom koraku
+   se sve varijable zamene jednom istom konstantom i dobijena osnovna
+   apstrakcija skupa klauza proverava DPLL resavacem:
+   - ako je apstrakcija nezadovoljiva, nezadovoljiv je i polazni skup;
+   - inace se iz svake klauze bira literal tacan u nadjenom modelu, pa se
+     za svaki par izabranih literala suprotnog znaka koji se mogu
+     unifikovati dodaju instance obe klauze najopstijim unifikatorom;
+   - ako nijedna instanca nije nova (do na preimenovanje varijabli), skup
+     klauza je zadovoljiv.
+   Umesto svih instanci nad termovima Erbranovog univerzuma, generisu se
+   samo instance koje razresavaju konflikte izabranih literala. Pretraga
+   odustaje posle maxClauses klauza */
+ProofResult instGen(Signature s, const Formula &f, const ProverOptions &opts);
+
+#endif
@@ -0,0 +1,430 @@
+#include "model_search.h"
+
+#include <algorithm>
+
+/* Interni zapis terma i formule u kome su varijable i simboli zamenjeni
+   rednim brojevima */
+struct SearchTerm {
+    int var;
+    unsigned symbol;
+    std::vector<SearchTerm> ops;
+};
+
+struct SearchFormula {
+    BaseFormula::Type type;
+    unsigned symbol;
+    std::vector<SearchTerm> args;
+    std::vector<SearchFormula> ops;
+};
+
+struct SearchSymbol {
+    std::string name;
+    unsigned arity;
+    bool relation;
+    bool equality;
+    size_t offset;
+};
+
+class ModelSearch {
+    unsigned m_size;
+    size_t m_maxNodes;
+    size_t m_nodes;
+
+    std::vector<SearchSymbol> m_symbols;
+    std::map<std::string, unsigned> m_functionIds;
+    std::map<std::string, unsigned> m_relationIds;
+    std::map<Variable, unsigned> m_varIds;
+    SearchFormula m_matrix;
+
+    /* Vrednosti celija, -1 oznacava nedodeljenu celiju */
+    std::vector<int> m_cells;
+    std::vector<unsigned> m_cellSymbol;
+    std::vector<int> m_cellMaxArg;
+    std::vector<size_t> m_order;
+
+    /* Sve valuacije varijabli matrice, jedna za drugom */
+    std::vector<unsigned> m_valuations;
+
+    unsigned symbolId(std::map<std::string, unsigned> &ids, const std::string &name,
+                      unsigned arity, bool relation);
+    SearchTerm compileTerm(const Term &t);
+    SearchFormula compileFormula(const Formula &f);
+
+    int evalTerm(const SearchTerm &t, const unsigned *val) const;
+    int evalFormula(const SearchFormula &f, const unsigned *val) const;
+    bool consistent() const;
+    bool search(size_t k, int maxUsed);
+public:
+    ModelSearch(const Formula &matrix, unsigned size, size_t maxNodes);
+    bool run(FiniteModel &model);
+};
+
+unsigned ModelSearch::symbolId(std::map<std::string, unsigned> &ids, const std::string &name,
+                               unsigned arity, bool relation)
+{
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    unsigned id = m_symbols.size();
+    m_symbols.push_back(SearchSymbol{name, arity, relation, false, 0});
+    ids.insert(std::make_pair(name, id));
+    return id;
+}
+
+SearchTerm ModelSearch::compileTerm(const Term &t)
+{
+    SearchTerm res;
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        const Variable &v = ((VariableTerm*)t.get())->getVariable();
+        auto it = m_varIds.find(v);
+        if (it == m_varIds.end()) {
+            it = m_varIds.insert(std::make_pair(v, (unsigned)m_varIds.size())).first;
+        }
+        res.var = it->second;
+        res.symbol = 0;
+    } else {
+        FunctionTerm *ft = (FunctionTerm*)t.get();
+        res.var = -1;
+        res.symbol = symbolId(m_functionIds, ft->getSymbol(), ft->getOperands().size(), false);
+        for (const Term &op : ft->getOperands()) {
+            res.ops.push_back(compileTerm(op));
+        }
+    }
+    return res;
+}
+
+SearchFormula ModelSearch::compileFormula(const Formula &f)
+{
+    SearchFormula res;
+    res.type = f->getType();
+    res.symbol = 0;
+
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        break;
+    case BaseFormula::T_ATOM: {
+        Atom *a = (Atom*)f.get();
+        res.symbol = symbolId(m_relationIds, a->getSymbol(), a->getOperands().size(), true);
+        m_symbols[res.symbol].equality = a->getSignature().isEquality(a->getSymbol());
+        for (const Term &op : a->getOperands()) {
+            res.args.push_back(compileTerm(op));
+        }
+        break;
+    }
+    case BaseFormula::T_NOT:
+        res.ops.push_back(compileFormula(((Not*)f.get())->getOperand()));
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF:
+        res.ops.push_back(compileFormula(((BinaryConnective*)f.get())->getOperand1()));
+        res.ops.push_back(compileFormula(((BinaryConnective*)f.get())->getOperand2()));
+        break;
+    default:
+        throw "Model search not applicable";
+    }
+    return res;
+}
+
+ModelSearch::ModelSearch(const Formula &matrix, unsigned size, size_t maxNodes)
+    : m_size(size), m_maxNodes(maxNodes), m_nodes(0)
+{
+    m_matrix = compileFormula(matrix);
+
+    /* Celije svih tablica su smestene u jedan niz */
+    size_t ncells = 0;
+    for (SearchSymbol &sym : m_symbols) {
+        sym.offset = ncells;
+        size_t count = 1;
+        for (unsigned i = 0; i < sym.arity; ++i) {
+            count *= m_size;
+        }
+        for (size_t c = 0; c < count; ++c) {
+            /* Najveci argument celije, -1 za konstante */
+            int maxArg = -1;
+            for (size_t rest = c, i = 0; i < sym.arity; ++i, rest /= m_size) {
+                maxArg = std::max(maxArg, (int)(rest % m_size));
+            }
+            m_cellSymbol.push_back(&sym - &m_symbols[0]);
+            m_cellMaxArg.push_back(maxArg);
+        }
+        ncells += count;
+    }
+    m_cells.assign(ncells, -1);
+
+    /* Jednakost je identitet, pa se njene celije ne pretrazuju */
+    for (const SearchSymbol &sym : m_symbols) {
+        if (sym.equality) {
+            for (size_t c = 0; c < m_size * m_size; ++c) {
+                m_cells[sym.offset + c] = c / m_size == c % m_size;
+            }
+        }
+    }
+
+    /* Celije se dodeljuju po rastucem najvecem argumentu, sto je potrebno
+    za ispravnost heuristike najmanjeg broja */
+    for (size_t c = 0; c < ncells; ++c) {
+        if (m_cells[c] < 0) {
+            m_order.push_back(c);
+        }
+    }
+    std::stable_sort(m_order.begin(), m_order.end(), [this](size_t a, size_t b) {
+        return m_cellMaxArg[a] < m_cellMaxArg[b];
+    });
+
+    size_t nvars = m_varIds.size();
+    size_t count = 1;
+    for (size_t i = 0; i < nvars; ++i) {
+        count *= m_size;
+    }
+    m_valuations.reserve(count * nvars);
+    for (size_t c = 0; c < count; ++c) {
+        for (size_t rest = c, i = 0; i < nvars; ++i, rest /= m_size) {
+            m_valuations.push_back(rest % m_size);
+        }
+    }
+}
+
+int ModelSearch::evalTerm(const SearchTerm &t, const unsigned *val) const
+{
+    if (t.var >= 0) {
+        return val[t.var];
+    }
+
+    const SearchSymbol &sym = m_symbols[t.symbol];
+    size_t index = 0;
+    for (const SearchTerm &op : t.ops) {
+        int v = evalTerm(op, val);
+        if (v < 0) {
+            return -1;
+        }
+        index = index * m_size + v;
+    }
+    return m_cells[sym.offset + index];
+}
+
+int ModelSearch::evalFormula(const SearchFormula &f, const unsigned *val) const
+{
+    /* Trovalentna (Klinijeva) logika: -1 je nepoznata vrednost */
+    switch (f.type) {
+    case BaseFormula::T_TRUE:
+        return 1;
+    case BaseFormula::T_FALSE:
+        return 0;
+    case BaseFormula::T_ATOM: {
+        const SearchSymbol &sym = m_symbols[f.symbol];
+        size_t index = 0;
+        for (const SearchTerm &op : f.args) {
+            int v = evalTerm(op, val);
+            if (v < 0) {
+                return -1;
+            }
+            index = index * m_size + v;
+        }
+        return m_cells[sym.offset + index];
+    }
+    case BaseFormula::T_NOT: {
+        int v = evalFormula(f.ops[0], val);
+        return v < 0 ? -1 : 1 - v;
+    }
+    case BaseFormula::T_AND: {
+        int v1 = evalFormula(f.ops[0], val);
+        if (v1 == 0) {
+            return 0;
+        }
+        int v2 = evalFormula(f.ops[1], val);
+        if (v2 == 0) {
+            return 0;
+        }
+        return v1 == 1 && v2 == 1 ? 1 : -1;
+    }
+    case BaseFormula::T_OR: {
+        int v1 = evalFormula(f.ops[0], val);
+        if (v1 == 1) {
+            return 1;
+        }
+        int v2 = evalFormula(f.ops[1], val);
+        if (v2 == 1) {
+            return 1;
+        }
+        return v1 == 0 && v2 == 0 ? 0 : -1;
+    }
+    case BaseFormula::T_IMP: {
+        int v1 = evalFormula(f.ops[0], val);
+        if (v1 == 0) {
+            return 1;
+        }
+        int v2 = evalFormula(f.ops[1], val);
+        if (v2 == 1) {
+            return 1;
+        }
+        return v1 == 1 && v2 == 0 ? 0 : -1;
+    }
+    case BaseFormula::T_IFF: {
+        int v1 = evalFormula(f.ops[0], val);
+        int v2 = evalFormula(f.ops[1], val);
+        if (v1 < 0 || v2 < 0) {
+            return -1;
+        }
+        return v1 == v2 ? 1 : 0;
+    }
+    default:
+        throw "Model search not applicable";
+    }
+}
+
+bool ModelSearch::consistent() const
+{
+    size_t nvars = m_varIds.size();
+    size_t count = nvars ? m_valuations.size() / nvars : 1;
+    for (size_t i = 0; i < count; ++i) {
+        if (evalFormula(m_matrix, m_valuations.data() + i * nvars) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ModelSearch::search(size_t k, int maxUsed)
+{
+    if (k == m_order.size()) {
+        return true;
+    }
+    if (++m_nodes > m_maxNodes) {
+        return false;
+    }
+
+    size_t c = m_order[k];
+    const SearchSymbol &sym = m_symbols[m_cellSymbol[c]];
+
+    if (sym.relation) {
+        for (int v = 0; v <= 1; ++v) {
+            m_cells[c] = v;
+            if (consistent() && search(k + 1, maxUsed)) {
+                return true;
+            }
+        }
+    } else {
+        /* Elementi veci od max(maxUsed, m_cellMaxArg[c]) se jos nigde ne
+        pojavljuju, pa su medjusobno simetricni i dovoljno je probati samo
+        prvi od njih */
+        int bound = std::min((int)m_size - 1, std::max(maxUsed, m_cellMaxArg[c]) + 1);
+        for (int v = 0; v <= bound; ++v) {
+            m_cells[c] = v;
+            if (consistent() && search(k + 1, std::max(maxUsed, v))) {
+                return true;
+            }
+        }
+    }
+
+    m_cells[c] = -1;
+    return false;
+}
+
+bool ModelSearch::run(FiniteModel &model)
+{
+    if (m_size == 0 || !consistent() || !search(0, -1)) {
+        return false;
+    }
+
+    model.size = m_size;
+    model.functions.clear();
+    model.relations.clear();
+    for (const SearchSymbol &sym : m_symbols) {
+        size_t count = 1;
+        for (unsigned i = 0; i < sym.arity; ++i) {
+            count *= m_size;
+        }
+        if (sym.relation) {
+            std::vector<bool> table;
+            for (size_t i = 0; i < count; ++i) {
+                table.push_back(m_cells[sym.offset + i] == 1);
+            }
+            model.relations[sym.name] = std::make_pair(sym.arity, table);
+        } else {
+            std::vector<unsigned> table;
+            for (size_t i = 0; i < count; ++i) {
+                table.push_back(m_cells[sym.offset + i]);
+            }
+            model.functions[sym.name] = std::make_pair(sym.arity, table);
+        }
+    }
+    return true;
+}
+
+bool findModel(const Formula &matrix, unsigned size, FiniteModel &model, size_t maxNodes)
+{
+    ModelSearch search(matrix, size, maxNodes);
+    return search.run(model);
+}
+
+Domain FiniteModel::domain() const
+{
+    Domain d;
+    for (unsigned i = 0; i < size; ++i) {
+        d.push_back(i);
+    }
+    return d;
+}
+
+void FiniteModel::fill(Structure &st) const
+{
+    for (const auto &f : functions) {
+        st.addFunction(f.first, new TableFunction(f.second.first, size, f.second.second));
+    }
+    for (const auto &r : relations) {
+        st.addRelation(r.first, new TableRelation(r.second.first, size, r.second.second));
+    }
+}
+
+/* Ispisuje argumente celije sa datim rednim brojem u tablici */
+static void printCellArgs(ostream &out, size_t index, unsigned arity, unsigned size)
+{
+    std::vector<unsigned> args(arity);
+    for (unsigned i = arity; i > 0; --i) {
+        args[i - 1] = index % size;
+        index /= size;
+    }
+    out << "(";
+    for (unsigned i = 0; i < arity; ++i) {
+        out << args[i] << (i + 1 < arity ? "," : "");
+    }
+    out << ")";
+}
+
+ostream & operator << (ostream &out, const FiniteModel &model)
+{
+    out << "Domain: { ";
+    for (unsigned i = 0; i < model.size; ++i) {
+        out << i << (i + 1 < model.size ? ", " : " ");
+    }
+    out << "}" << endl;
+
+    for (const auto &f : model.functions) {
+        const std::vector<unsigned> &table = f.second.second;
+        for (size_t i = 0; i < table.size(); ++i) {
+            out << f.first;
+            if (f.second.first > 0) {
+                printCellArgs(out, i, f.second.first, model.size);
+            }
+            out << " = " << table[i] << endl;
+        }
+    }
+
+    for (const auto &r : model.relations) {
+        const std::vector<bool> &table = r.second.second;
+        out << r.first << " = { ";
+        for (size_t i = 0; i < table.size(); ++i) {
+            if (table[i]) {
+                printCellArgs(out, i, r.second.first, model.size);
+                out << " ";
+            }
+        }
+        out << "}" << endl;
+    }
+    return out;
+}
@@ -0,0 +1,37 @@
+#ifndef MODEL_SEARCH_H
+#define MODEL_SEARCH_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "first_order_logic.h"
+
+/* Konacan model nad domenom {0,...,n-1}. Svaki simbol je zadat arnoscu i
+   tablicom vrednosti u rasporedu kao kod TableFunction/TableRelation */
+struct FiniteModel {
+    unsigned size = 0;
+    std::map< FunctionSymbol, std::pair< unsigned, std::vector<unsigned> > > functions;
+    std::map< PredicateSymbol, std::pair< unsigned, std::vector<bool> > > relations;
+
+    /* Domen {0,...,n-1} */
+    Domain domain() const;
+
+    /* Dodaje interpretacije simbola u strukturu (domen strukture mora biti
+    domain()) */
+    void fill(Structure &st) const;
+};
+
+ostream & operator << (ostream &out, const FiniteModel &model);
+
+/* Trazi model univerzalnog zatvorenja formule bez kvantifikatora (na primer
+   skolemizovane matrice) sa domenom velicine size, u stilu MACE-a: celije
+   tablica se dodeljuju redom, delimicna interpretacija se proverava
+   trovalentnom evaluacijom svih instanci, a simetrije domena se razbijaju
+   heuristikom najmanjeg broja (vrednost celije je najvise za jedan veca od
+   najveceg do tada upotrebljenog elementa). Vraca false ako model ne
+   postoji ili je prekoracen broj cvorova pretrage maxNodes */
+bool findModel(const Formula &matrix, unsigned size, FiniteModel &model, size_t maxNodes = 1000000);
+
+#endif
@@ -0,0 +1,120 @@
+#include "portfolio.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+std::vector<ProverOptions> portfolioConfigurations(const ProverOptions &opts)
+{
+    ProverOptions base = opts;
+    base.miniscope = false;
+    base.perClause = false;
+    base.clausal = false;
+    base.modelSearch = false;
+    base.simplifyGround = true;
+
+    std::vector<ProverOptions> configs;
+
+    ProverOptions gilmoreModels = base;
+    gilmoreModels.strategy = S_GILMORE;
+    gilmoreModels.clausal = true;
+    gilmoreModels.modelSearch = true;
+    configs.push_back(gilmoreModels);
+
+    ProverOptions gilmoreSplit = base;
+    gilmoreSplit.strategy = S_GILMORE;
+    gilmoreSplit.miniscope = true;
+    gilmoreSplit.perClause = true;
+    gilmoreSplit.clausal = true;
+    configs.push_back(gilmoreSplit);
+
+    ProverOptions resolution = base;
+    resolution.strategy = S_RESOLUTION;
+    configs.push_back(resolution);
+
+    ProverOptions instGen = base;
+    instGen.strategy = S_INSTGEN;
+    configs.push_back(instGen);
+
+    ProverOptions connection = base;
+    connection.strategy = S_CONNECTION;
+    configs.push_back(connection);
+
+    return configs;
+}
+
+static const char *strategyName(const ProverOptions &opts)
+{
+    switch (opts.strategy) {
+    case S_GILMORE:
+        return opts.perClause ? "gilmore (miniscope, perClause)" : "gilmore (modelSearch)";
+    case S_RESOLUTION:
+        return "resolution";
+    case S_INSTGEN:
+        return "instgen";
+    case S_CONNECTION:
+        return "connection";
+    default:
+        return "portfolio";
+    }
+}
+
+ProofResult portfolio(Signature s, const Formula &f, const ProverOptions &opts)
+{
+    std::vector<ProverOptions> configs = portfolioConfigurations(opts);
+    CancellationToken token;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    ProofResult result = PR_UNKNOWN;
+    size_t winner = configs.size();
+    size_t finished = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        configs[i].verbose = false;
+        configs[i].cancellation = &token;
+
+        threads.push_back(std::thread([&, i]() {
+            /* Svaka nit radi nad svojom kopijom signature (prove je prima
+            po vrednosti), a brojaci novih simbola su lokalni za nit */
+            ProofResult r = PR_UNKNOWN;
+            try {
+                r = prove(s, f, configs[i]);
+            } catch (...) {
+                r = PR_UNKNOWN;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ++finished;
+            if (r != PR_UNKNOWN && winner == configs.size()) {
+                result = r;
+                winner = i;
+                token.cancel();
+            }
+            done.notify_one();
+        }));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (winner == configs.size() && finished < configs.size()) {
+            done.wait_for(lock, std::chrono::milliseconds(10));
+            if (opts.cancelled()) {
+                token.cancel();
+            }
+        }
+    }
+
+    token.cancel();
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    if (opts.verbose && result != PR_UNKNOWN) {
+        std::cout << (result == PR_UNSAT ? "UNSAT" : "SAT") << std::endl;
+        std::cout << "Portfolio: " << strategyName(configs[winner]) << std::endl;
+    }
+    return result;
+}
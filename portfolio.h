@@ -0,0 +1,21 @@
+#ifndef PORTFOLIO_H
+#define PORTFOLIO_H
+
+#include <vector>
+
+#include "first_order_logic.h"
+#include "gilmore.h"
+
+/* Konfiguracije koje pokrece portfolio: Gilmorova procedura sa DPLL
+   proverom i pretragom modela, Gilmorova procedura sa miniscoping-om i
+   instanciranjem po konjunktima, rezolucija, Inst-Gen i konekcioni tablo.
+   Ostala podesavanja (granice) se preuzimaju iz opts */
+std::vector<ProverOptions> portfolioConfigurations(const ProverOptions &opts);
+
+/* Pokrece sve konfiguracije istovremeno, svaku u posebnoj niti i sa
+   sopstvenom kopijom signature. Vraca prvi definitivan ishod (PR_UNSAT ili
+   PR_SAT), a ostale niti prekida zajednickim zahtevom za prekid. Ako se
+   nijedna konfiguracija ne izjasni, vraca PR_UNKNOWN */
+ProofResult portfolio(Signature s, const Formula &f, const ProverOptions &opts);
+
+#endif
@@ -0,0 +1,327 @@
+#include "resolution.h"
+#include "unification.h"
+#include "ground.h"
+
+#include <set>
+
+/* Klauza prvog reda. Varijable zadrzanih klauza su imenovane X0, X1, ...
+   redom pojavljivanja, pa su varijante iste klauze i sintaksno jednake */
+struct ResolutionClause {
+    LiteralList literals;
+    size_t weight;
+    unsigned firstRef;
+    bool active;
+    bool deleted;
+};
+
+class ResolutionProver {
+    std::vector<ResolutionClause> m_clauses;
+
+    /* Neobradjene klauze, uredjene po tezini pa po redosledu nastanka */
+    std::set< std::pair<size_t, unsigned> > m_passive;
+
+    /* Literali su u indeksima predstavljeni rednim brojem para (klauza,
+    pozicija literala) */
+    std::vector< std::pair<unsigned, unsigned> > m_refs;
+    DiscriminationTree m_kept;
+    DiscriminationTree m_active;
+
+    const ProverOptions &m_opts;
+    bool m_refuted;
+
+    bool subsumed(const LiteralList &literals) const;
+    void removeSubsumed(const LiteralList &literals);
+    void activate(unsigned c);
+    void factors(unsigned c, LiteralListList &inferred) const;
+    void resolvents(unsigned c, LiteralListList &inferred) const;
+
+public:
+    ResolutionProver(const ProverOptions &opts);
+
+    /* Dodaje klauzu, ako nije tautologija i ako je ne supsumira neka
+    zadrzana klauza. Obradjene klauze ulaze odmah u skup za rezoluciju */
+    void addClause(const LiteralList &literals, bool active);
+
+    ProofResult run(bool setOfSupport);
+};
+
+static Formula literalAtom(const Formula &l)
+{
+    return l->getType() == BaseFormula::T_NOT ? ((Not*)l.get())->getOperand() : l;
+}
+
+static Formula complement(const Formula &l)
+{
+    if (l->getType() == BaseFormula::T_NOT) {
+        return ((Not*)l.get())->getOperand();
+    }
+    return std::make_shared<Not>(l);
+}
+
+static size_t termWeight(const Term &t)
+{
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        return 1;
+    }
+    size_t w = 1;
+    for (const Term &op : ((FunctionTerm*)t.get())->getOperands()) {
+        w += termWeight(op);
+    }
+    return w;
+}
+
+static size_t clauseWeight(const LiteralList &literals)
+{
+    size_t w = 0;
+    for (const Formula &l : literals) {
+        w += 1;
+        for (const Term &op : ((Atom*)literalAtom(l).get())->getOperands()) {
+            w += termWeight(op);
+        }
+    }
+    return w;
+}
+
+/* Da li postoji supstitucija s takva da je c[i..]s podskup od d */
+static bool subsumesFrom(const LiteralList &c, size_t i, const LiteralList &d, Substitution &s)
+{
+    if (i == c.size()) {
+        return true;
+    }
+
+    for (const Formula &l : d) {
+        Substitution saved = s;
+        if (match(c[i], l, s)) {
+            if (subsumesFrom(c, i + 1, d, s)) {
+                return true;
+            }
+            s = saved;
+        }
+    }
+    return false;
+}
+
+static bool subsumes(const LiteralList &c, const LiteralList &d)
+{
+    if (c.size() > d.size()) {
+        return false;
+    }
+    Substitution s;
+    return subsumesFrom(c, 0, d, s);
+}
+
+ResolutionProver::ResolutionProver(const ProverOptions &opts)
+    : m_opts(opts), m_refuted(false)
+{
+}
+
+bool ResolutionProver::subsumed(const LiteralList &literals) const
+{
+    /* Klauza koja supsumira datu mora imati prvi literal koji je uopstenje
+    nekog literala date klauze */
+    for (const Formula &l : literals) {
+        for (unsigned ref : m_kept.generalizations(l)) {
+            const std::pair<unsigned, unsigned> &r = m_refs[ref];
+            if (r.second == 0 && !m_clauses[r.first].deleted &&
+                    subsumes(m_clauses[r.first].literals, literals)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ResolutionProver::removeSubsumed(const LiteralList &literals)
+{
+    std::set<unsigned> candidates;
+    for (unsigned ref : m_kept.instances(literals[0])) {
+        candidates.insert(m_refs[ref].first);
+    }
+
+    for (unsigned c : candidates) {
+        ResolutionClause &clause = m_clauses[c];
+        if (clause.deleted || !subsumes(literals, clause.literals)) {
+            continue;
+        }
+
+        clause.deleted = true;
+        for (unsigned i = 0; i < clause.literals.size(); ++i) {
+            m_kept.remove(clause.literals[i], clause.firstRef + i);
+            if (clause.active) {
+                m_active.remove(clause.literals[i], clause.firstRef + i);
+            }
+        }
+    }
+}
+
+void ResolutionProver::addClause(const LiteralList &literals, bool active)
+{
+    LiteralList normalized = renameClause(literals, "X");
+
+    /* Uklanjanje ponovljenih literala i odbacivanje tautologija */
+    LiteralList clause;
+    std::set<std::string> keys;
+    for (const Formula &l : normalized) {
+        if (keys.find(atomKey(complement(l))) != keys.end()) {
+            return;
+        }
+        if (keys.insert(atomKey(l)).second) {
+            clause.push_back(l);
+        }
+    }
+
+    if (clause.empty()) {
+        m_refuted = true;
+        return;
+    }
+
+    if (subsumed(clause)) {
+        return;
+    }
+    removeSubsumed(clause);
+
+    unsigned c = m_clauses.size();
+    m_clauses.push_back(ResolutionClause{ clause, clauseWeight(clause), (unsigned)m_refs.size(), false, false });
+    for (unsigned i = 0; i < clause.size(); ++i) {
+        m_kept.insert(clause[i], m_refs.size());
+        m_refs.push_back(std::make_pair(c, i));
+    }
+
+    if (active) {
+        activate(c);
+    } else {
+        m_passive.insert(std::make_pair(m_clauses[c].weight, c));
+    }
+}
+
+void ResolutionProver::activate(unsigned c)
+{
+    ResolutionClause &clause = m_clauses[c];
+    clause.active = true;
+    for (unsigned i = 0; i < clause.literals.size(); ++i) {
+        m_active.insert(clause.literals[i], clause.firstRef + i);
+    }
+}
+
+void ResolutionProver::factors(unsigned c, LiteralListList &inferred) const
+{
+    const LiteralList &literals = m_clauses[c].literals;
+    for (size_t i = 0; i < literals.size(); ++i) {
+        for (size_t j = i + 1; j < literals.size(); ++j) {
+            Substitution s;
+            if (!unify(literals[i], literals[j], s)) {
+                continue;
+            }
+
+            LiteralList factor;
+            for (size_t k = 0; k < literals.size(); ++k) {
+                if (k != j) {
+                    factor.push_back(applySubstitution(literals[k], s));
+                }
+            }
+            inferred.push_back(factor);
+        }
+    }
+}
+
+void ResolutionProver::resolvents(unsigned c, LiteralListList &inferred) const
+{
+    /* Izabrana klauza se preimenuje, kako ne bi delila varijable sa
+    obradjenim klauzama (ukljucujuci i samu sebe) */
+    LiteralList given = renameClause(m_clauses[c].literals, "Y");
+
+    for (size_t i = 0; i < given.size(); ++i) {
+        Formula comp = complement(given[i]);
+
+        for (unsigned ref : m_active.unifiable(comp)) {
+            const ResolutionClause &partner = m_clauses[m_refs[ref].first];
+            size_t j = m_refs[ref].second;
+
+            Substitution s;
+            if (!unify(comp, partner.literals[j], s)) {
+                continue;
+            }
+
+            LiteralList resolvent;
+            for (size_t k = 0; k < given.size(); ++k) {
+                if (k != i) {
+                    resolvent.push_back(applySubstitution(given[k], s));
+                }
+            }
+            for (size_t k = 0; k < partner.literals.size(); ++k) {
+                if (k != j) {
+                    resolvent.push_back(applySubstitution(partner.literals[k], s));
+                }
+            }
+            inferred.push_back(resolvent);
+        }
+    }
+}
+
+ProofResult ResolutionProver::run(bool setOfSupport)
+{
+    while (!m_refuted && !m_passive.empty()) {
+        if (m_clauses.size() > m_opts.maxClauses || m_opts.cancelled()) {
+            return PR_UNKNOWN;
+        }
+
+        unsigned c = m_passive.begin()->second;
+        m_passive.erase(m_passive.begin());
+        if (m_clauses[c].deleted) {
+            continue;
+        }
+
+        activate(c);
+
+        LiteralListList inferred;
+        factors(c, inferred);
+        resolvents(c, inferred);
+
+        for (const LiteralList &clause : inferred) {
+            addClause(clause, false);
+            if (m_refuted) {
+                break;
+            }
+        }
+    }
+
+    if (m_refuted) {
+        return PR_UNSAT;
+    }
+
+    /* Zasicenje sa skupom potpore ne znaci zadovoljivost, jer klauze van
+    skupa potpore nisu medjusobno razresavane */
+    return setOfSupport ? PR_UNKNOWN : PR_SAT;
+}
+
+ProofResult resolution(Signature s, const Formula &axioms, const Formula &goal, const ProverOptions &opts)
+{
+    bool setOfSupport = opts.setOfSupport && axioms;
+    ResolutionProver prover(opts);
+
+    if (axioms) {
+        for (const LiteralList &clause : skolemMatrix(s, axioms, opts)->definitionalCNF(s)) {
+            prover.addClause(clause, setOfSupport);
+        }
+    }
+    for (const LiteralList &clause : skolemMatrix(s, goal, opts)->definitionalCNF(s)) {
+        prover.addClause(clause, false);
+    }
+
+    ProofResult res = prover.run(setOfSupport);
+
+    /* Bez aksioma jednakosti zasicenje ne dokazuje zadovoljivost ako
+    signatura ima jednakost */
+    if (res == PR_SAT && s.hasEquality()) {
+        res = PR_UNKNOWN;
+    }
+    if (!opts.verbose) {
+        return res;
+    }
+    if (res == PR_UNSAT) {
+        std::cout << "UNSAT" << std::endl;
+    } else if (res == PR_SAT) {
+        std::cout << "SAT" << std::endl;
+    }
+    return res;
+}
@@ -0,0 +1,23 @@
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include "first_order_logic.h"
+#include "gilmore.h"
+
+/* Saturacioni dokazivac zasnovan na binarnoj rezoluciji i faktorisanju,
+   sa petljom izabrane klauze (given-clause): iz skupa neobradjenih klauza
+   se bira najlaksa, izvode se svi njeni faktori i rezolvente sa obradjenim
+   klauzama, a nove klauze se odbacuju ako su tautologije ili ako ih
+   supsumira neka zadrzana klauza (unapred), odnosno uklanjaju zadrzane
+   klauze koje same supsumiraju (unazad).
+
+   Proverava se nezadovoljivost konjunkcije formula axioms i goal. Formule
+   prolaze istu pripremu kao kod Gilmorove procedure (skolemMatrix), pa se
+   svode na klauze definicionom KNF. Ako je ukljucen skup potpore, klauze
+   formule axioms se smatraju zadovoljivim i samo se medjusobno ne
+   razresavaju; ako axioms nije zadat, sve klauze su u skupu potpore.
+   Zasicenje skupa klauza znaci zadovoljivost samo bez skupa potpore, a
+   prekoracenje granice maxClauses daje PR_UNKNOWN */
+ProofResult resolution(Signature s, const Formula &axioms, const Formula &goal, const ProverOptions &opts);
+
+#endif
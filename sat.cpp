@@ -0,0 +1,194 @@
+#include "sat.h"
+
+#include <cstdlib>
+
+SatSolver::SatSolver(unsigned nvars)
+    : m_nvars(nvars), m_empty(false), m_watches(2 * nvars), m_assign(nvars, -1), m_qhead(0)
+{}
+
+size_t SatSolver::watchIndex(Lit l)
+{
+    return 2 * (std::abs(l) - 1) + (l < 0 ? 1 : 0);
+}
+
+int SatSolver::value(Lit l) const
+{
+    signed char v = m_assign[std::abs(l) - 1];
+    if (v < 0) {
+        return -1;
+    }
+    return l > 0 ? v : 1 - v;
+}
+
+void SatSolver::enqueue(Lit l)
+{
+    m_assign[std::abs(l) - 1] = l > 0 ? 1 : 0;
+    m_trail.push_back(l);
+}
+
+void SatSolver::undo(size_t trailSize)
+{
+    while (m_trail.size() > trailSize) {
+        m_assign[std::abs(m_trail.back()) - 1] = -1;
+        m_trail.pop_back();
+    }
+    m_qhead = trailSize;
+}
+
+void SatSolver::addWatched(unsigned c)
+{
+    m_watches[watchIndex(m_clauses[c][0])].push_back(c);
+    m_watches[watchIndex(m_clauses[c][1])].push_back(c);
+}
+
+void SatSolver::addClause(const Clause &c)
+{
+    Clause clause;
+    for (Lit l : c) {
+        unsigned var = std::abs(l);
+        if (var > m_nvars) {
+            m_nvars = var;
+            m_assign.resize(m_nvars, -1);
+            m_watches.resize(2 * m_nvars);
+        }
+
+        /* Duplikati se izbacuju, a tautologije se ne dodaju */
+        bool skip = false;
+        for (Lit k : clause) {
+            if (k == l) {
+                skip = true;
+            } else if (k == -l) {
+                return;
+            }
+        }
+        if (!skip) {
+            clause.push_back(l);
+        }
+    }
+
+    if (clause.empty()) {
+        m_empty = true;
+    } else if (clause.size() == 1) {
+        m_units.push_back(clause[0]);
+    } else {
+        m_clauses.push_back(clause);
+        addWatched(m_clauses.size() - 1);
+    }
+}
+
+bool SatSolver::propagate()
+{
+    while (m_qhead < m_trail.size()) {
+        Lit p = m_trail[m_qhead++];
+        Lit falseLit = -p;
+        std::vector<unsigned> &ws = m_watches[watchIndex(falseLit)];
+
+        size_t i = 0, j = 0;
+        bool conflict = false;
+        while (i < ws.size()) {
+            unsigned ci = ws[i++];
+            Clause &c = m_clauses[ci];
+
+            if (c[0] == falseLit) {
+                std::swap(c[0], c[1]);
+            }
+
+            if (value(c[0]) == 1) {
+                ws[j++] = ci;
+                continue;
+            }
+
+            /* Trazimo novi literal koji nije netacan */
+            bool moved = false;
+            for (size_t k = 2; k < c.size(); ++k) {
+                if (value(c[k]) != 0) {
+                    std::swap(c[1], c[k]);
+                    m_watches[watchIndex(c[1])].push_back(ci);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) {
+                continue;
+            }
+
+            ws[j++] = ci;
+            if (value(c[0]) == 0) {
+                conflict = true;
+                while (i < ws.size()) {
+                    ws[j++] = ws[i++];
+                }
+            } else {
+                enqueue(c[0]);
+            }
+        }
+        ws.resize(j);
+
+        if (conflict) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SatSolver::solve()
+{
+    if (m_empty) {
+        return false;
+    }
+
+    undo(0);
+    m_decisions.clear();
+
+    for (Lit l : m_units) {
+        int v = value(l);
+        if (v == 0) {
+            return false;
+        } else if (v < 0) {
+            enqueue(l);
+        }
+    }
+
+    unsigned next = 0;
+    while (true) {
+        if (!propagate()) {
+            /* Hronoloski povratak do poslednje odluke koja nije obrnuta */
+            while (true) {
+                if (m_decisions.empty()) {
+                    return false;
+                }
+                Decision d = m_decisions.back();
+                m_decisions.pop_back();
+                undo(d.trailSize);
+                if (!d.flipped) {
+                    m_decisions.push_back(Decision{d.trailSize, -d.lit, true});
+                    enqueue(-d.lit);
+                    break;
+                }
+            }
+            next = 0;
+            continue;
+        }
+
+        while (next < m_nvars && m_assign[next] >= 0) {
+            ++next;
+        }
+        if (next == m_nvars) {
+            return true;
+        }
+
+        Lit l = -(Lit)(next + 1);
+        m_decisions.push_back(Decision{m_trail.size(), l, false});
+        enqueue(l);
+    }
+}
+
+bool SatSolver::modelValue(unsigned id) const
+{
+    return id < m_nvars && m_assign[id] == 1;
+}
+
+unsigned SatSolver::numVars() const
+{
+    return m_nvars;
+}
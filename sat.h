@@ -0,0 +1,51 @@
+#ifndef SAT_H
+#define SAT_H
+
+#include <vector>
+
+#include "ground.h"
+
+/* DPLL resavac za iskazne formule u KNF-u, zadate celobrojnim literalima
+   (videti ground.h). Propagacija jedinicnih klauza koristi dva posmatrana
+   literala po klauzi. */
+class SatSolver {
+    unsigned m_nvars;
+    std::vector<Clause> m_clauses;
+    std::vector<Lit> m_units;
+    bool m_empty;
+
+    std::vector< std::vector<unsigned> > m_watches;
+    std::vector<signed char> m_assign;
+    std::vector<Lit> m_trail;
+    size_t m_qhead;
+
+    struct Decision {
+        size_t trailSize;
+        Lit lit;
+        bool flipped;
+    };
+    std::vector<Decision> m_decisions;
+
+    static size_t watchIndex(Lit l);
+    int value(Lit l) const;
+    void enqueue(Lit l);
+    void undo(size_t trailSize);
+    bool propagate();
+    void addWatched(unsigned c);
+public:
+    SatSolver(unsigned nvars = 0);
+
+    /* Dodaje klauzu; varijable van opsega prosiruju resavac */
+    void addClause(const Clause &c);
+
+    /* Ispituje zadovoljivost skupa klauza. Moze se pozivati vise puta,
+    i izmedju poziva se mogu dodavati nove klauze */
+    bool solve();
+
+    /* Vrednost varijable (atoma) id u nadjenom modelu */
+    bool modelValue(unsigned id) const;
+
+    unsigned numVars() const;
+};
+
+#endif
@@ -0,0 +1,461 @@
+#include "serialize.h"
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char MAGIC[4] = { 'G', 'S', 'E', 'R' };
+
+/* Vrste cvorova; brojevi su deo formata i ne zavise od redosleda
+   nabrojivih tipova u first_order_logic.h */
+enum NodeKind {
+    N_VARIABLE = 1, N_FUNCTION,
+    N_TRUE, N_FALSE, N_ATOM, N_NOT, N_AND, N_OR, N_IMP, N_IFF, N_FORALL, N_EXISTS
+};
+
+/* Cvor je vrsta, niska i broj dece, pa indeksi dece */
+static const size_t NODE_HEADER = 3;
+
+/* Broj reci koje zauzimaju znaci niske date duzine */
+static size_t stringWords(size_t length)
+{
+    return (length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+}
+
+BinaryWriter::BinaryWriter(SerializedKind kind)
+    : m_kind(kind), m_nodeCount(0)
+{}
+
+uint32_t BinaryWriter::stringId(const std::string &str)
+{
+    auto it = m_stringIds.find(str);
+    if (it != m_stringIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = m_strings.size();
+    m_strings.push_back(str);
+    m_stringIds.insert(std::make_pair(str, id));
+    return id;
+}
+
+uint32_t BinaryWriter::node(const std::vector<uint32_t> &record)
+{
+    auto it = m_nodeIds.find(record);
+    if (it != m_nodeIds.end()) {
+        return it->second;
+    }
+
+    m_nodes.insert(m_nodes.end(), record.begin(), record.end());
+    m_nodeIds.insert(std::make_pair(record, m_nodeCount));
+    return m_nodeCount++;
+}
+
+uint32_t BinaryWriter::termNode(const Term &t)
+{
+    /* Isti objekat se ne obilazi ponovo; objekti se cuvaju dok traje
+    zapisivanje, pa se njihove adrese ne mogu ponovo iskoristiti */
+    auto it = m_written.find(t.get());
+    if (it != m_written.end()) {
+        return it->second;
+    }
+
+    std::vector<uint32_t> record;
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        record = { N_VARIABLE, stringId(((VariableTerm*)t.get())->getVariable()), 0 };
+    } else {
+        FunctionTerm *ft = (FunctionTerm*)t.get();
+        record = { N_FUNCTION, stringId(ft->getSymbol()), (uint32_t)ft->getOperands().size() };
+        for (const Term &op : ft->getOperands()) {
+            record.push_back(termNode(op));
+        }
+    }
+
+    uint32_t id = node(record);
+    m_written.insert(std::make_pair(t.get(), id));
+    m_writtenTerms.push_back(t);
+    return id;
+}
+
+uint32_t BinaryWriter::formulaNode(const Formula &f)
+{
+    auto it = m_written.find(f.get());
+    if (it != m_written.end()) {
+        return it->second;
+    }
+
+    std::vector<uint32_t> record;
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+        record = { N_TRUE, 0, 0 };
+        break;
+    case BaseFormula::T_FALSE:
+        record = { N_FALSE, 0, 0 };
+        break;
+    case BaseFormula::T_ATOM: {
+        Atom *a = (Atom*)f.get();
+        record = { N_ATOM, stringId(a->getSymbol()), (uint32_t)a->getOperands().size() };
+        for (const Term &op : a->getOperands()) {
+            record.push_back(termNode(op));
+        }
+        break;
+    }
+    case BaseFormula::T_NOT:
+        record = { N_NOT, 0, 1, formulaNode(((Not*)f.get())->getOperand()) };
+        break;
+    case BaseFormula::T_AND:
+    case BaseFormula::T_OR:
+    case BaseFormula::T_IMP:
+    case BaseFormula::T_IFF: {
+        static const NodeKind kinds[] = { N_AND, N_OR, N_IMP, N_IFF };
+        BinaryConnective *b = (BinaryConnective*)f.get();
+        record = { kinds[f->getType() - BaseFormula::T_AND], 0, 2,
+                   formulaNode(b->getOperand1()), formulaNode(b->getOperand2()) };
+        break;
+    }
+    case BaseFormula::T_FORALL:
+    case BaseFormula::T_EXISTS: {
+        Quantifier *q = (Quantifier*)f.get();
+        record = { f->getType() == BaseFormula::T_FORALL ? N_FORALL : N_EXISTS, stringId(q->getVariable()), 1,
+                   formulaNode(q->getOperand()) };
+        break;
+    }
+    }
+
+    uint32_t id = node(record);
+    m_written.insert(std::make_pair(f.get(), id));
+    m_writtenFormulas.push_back(f);
+    return id;
+}
+
+void BinaryWriter::number(uint32_t n)
+{
+    m_body.push_back(n);
+}
+
+void BinaryWriter::string(const std::string &str)
+{
+    m_body.push_back(stringId(str));
+}
+
+void BinaryWriter::term(const Term &t)
+{
+    m_body.push_back(termNode(t));
+}
+
+void BinaryWriter::formula(const Formula &f)
+{
+    m_body.push_back(formulaNode(f));
+}
+
+void BinaryWriter::signature(const Signature &s)
+{
+    number(s.hasEquality());
+    number(s.getFunctionSymbols().size());
+    for (const auto &f : s.getFunctionSymbols()) {
+        string(f.first);
+        number(f.second);
+    }
+    number(s.getPredicateSymbols().size());
+    for (const auto &p : s.getPredicateSymbols()) {
+        string(p.first);
+        number(p.second);
+    }
+}
+
+void BinaryWriter::literals(const Clause &c)
+{
+    number(c.size());
+    for (Lit l : c) {
+        number(l);
+    }
+}
+
+void BinaryWriter::save(const std::string &path) const
+{
+    std::vector<uint32_t> words;
+    uint32_t magic;
+    std::copy(MAGIC, MAGIC + sizeof(MAGIC), (char *)&magic);
+    words.push_back(magic);
+    words.push_back(FORMAT_VERSION);
+    words.push_back(m_kind);
+
+    words.push_back(m_strings.size());
+    for (const std::string &str : m_strings) {
+        words.push_back(str.size());
+        size_t start = words.size();
+        words.resize(start + stringWords(str.size()), 0);
+        std::copy(str.begin(), str.end(), (char *)(words.data() + start));
+    }
+
+    words.push_back(m_nodeCount);
+    words.insert(words.end(), m_nodes.begin(), m_nodes.end());
+
+    words.push_back(m_body.size());
+    words.insert(words.end(), m_body.begin(), m_body.end());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write((const char *)words.data(), words.size() * sizeof(uint32_t));
+    out.close();
+    if (!out) {
+        throw "Cannot write file";
+    }
+}
+
+BinaryReader::BinaryReader(const std::string &path, SerializedKind kind, const Signature &s)
+    : m_signature(s), m_data(nullptr), m_size(0), m_body(0), m_pos(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw "Cannot open file";
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0 || st.st_size % sizeof(uint32_t) != 0) {
+        close(fd);
+        throw "Bad file";
+    }
+
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw "Cannot map file";
+    }
+    m_data = (const uint32_t *)data;
+    m_size = st.st_size / sizeof(uint32_t);
+
+    try {
+        if (std::string((const char *)m_data, std::min(m_size * sizeof(uint32_t), sizeof(MAGIC))) !=
+                std::string(MAGIC, sizeof(MAGIC))) {
+            throw "Bad file";
+        }
+        if (word(1) != FORMAT_VERSION) {
+            throw "Unsupported format version";
+        }
+        if (word(2) != (uint32_t)kind) {
+            throw "Unexpected file kind";
+        }
+
+        size_t i = 3;
+        for (uint32_t n = word(i++); n > 0; --n) {
+            uint32_t length = word(i);
+            if (i + 1 + stringWords(length) > m_size) {
+                throw "Bad file";
+            }
+            m_strings.push_back(std::make_pair((const char *)(m_data + i + 1), length));
+            i += 1 + stringWords(length);
+        }
+
+        for (uint32_t n = word(i++); n > 0; --n) {
+            uint32_t count = word(i + 2);
+            for (uint32_t c = 0; c < count; ++c) {
+                if (word(i + NODE_HEADER + c) >= m_nodes.size()) {
+                    throw "Bad file";
+                }
+            }
+            m_nodes.push_back(i);
+            i += NODE_HEADER + count;
+        }
+        m_terms.resize(m_nodes.size());
+        m_formulas.resize(m_nodes.size());
+
+        if (i + 1 + word(i) != m_size) {
+            throw "Bad file";
+        }
+        m_body = i + 1;
+    } catch (...) {
+        munmap((void *)m_data, m_size * sizeof(uint32_t));
+        throw;
+    }
+}
+
+BinaryReader::~BinaryReader()
+{
+    munmap((void *)m_data, m_size * sizeof(uint32_t));
+}
+
+uint32_t BinaryReader::word(size_t i) const
+{
+    if (i >= m_size) {
+        throw "Bad file";
+    }
+    return m_data[i];
+}
+
+std::string BinaryReader::stringAt(uint32_t id) const
+{
+    if (id >= m_strings.size()) {
+        throw "Bad file";
+    }
+    return std::string(m_strings[id].first, m_strings[id].second);
+}
+
+void BinaryReader::children(uint32_t id, std::vector<uint32_t> &res) const
+{
+    size_t i = m_nodes[id];
+    res.assign(m_data + i + NODE_HEADER, m_data + i + NODE_HEADER + m_data[i + 2]);
+}
+
+Term BinaryReader::termNode(uint32_t id)
+{
+    if (id >= m_nodes.size()) {
+        throw "Bad file";
+    }
+    if (m_terms[id]) {
+        return m_terms[id];
+    }
+
+    size_t i = m_nodes[id];
+    std::vector<uint32_t> ids;
+    children(id, ids);
+
+    if (m_data[i] == N_VARIABLE) {
+        m_terms[id] = std::make_shared<VariableTerm>(stringAt(m_data[i + 1]));
+    } else if (m_data[i] == N_FUNCTION) {
+        std::vector<Term> ops;
+        for (uint32_t c : ids) {
+            ops.push_back(termNode(c));
+        }
+        m_terms[id] = std::make_shared<FunctionTerm>(m_signature, stringAt(m_data[i + 1]), std::move(ops));
+    } else {
+        throw "Bad file";
+    }
+    return m_terms[id];
+}
+
+Formula BinaryReader::formulaNode(uint32_t id)
+{
+    if (id >= m_nodes.size()) {
+        throw "Bad file";
+    }
+    if (m_formulas[id]) {
+        return m_formulas[id];
+    }
+
+    size_t i = m_nodes[id];
+    std::vector<uint32_t> ids;
+    children(id, ids);
+
+    uint32_t kind = m_data[i];
+    size_t expected = kind == N_TRUE || kind == N_FALSE ? 0 :
+                      kind == N_NOT || kind == N_FORALL || kind == N_EXISTS ? 1 : 2;
+    if (kind != N_ATOM && ids.size() != expected) {
+        throw "Bad file";
+    }
+
+    Formula res;
+    switch (kind) {
+    case N_TRUE:
+        res = std::make_shared<True>();
+        break;
+    case N_FALSE:
+        res = std::make_shared<False>();
+        break;
+    case N_ATOM: {
+        std::vector<Term> ops;
+        for (uint32_t c : ids) {
+            ops.push_back(termNode(c));
+        }
+        res = std::make_shared<Atom>(m_signature, stringAt(m_data[i + 1]), std::move(ops));
+        break;
+    }
+    case N_NOT:
+        res = std::make_shared<Not>(formulaNode(ids[0]));
+        break;
+    case N_AND:
+        res = std::make_shared<And>(formulaNode(ids[0]), formulaNode(ids[1]));
+        break;
+    case N_OR:
+        res = std::make_shared<Or>(formulaNode(ids[0]), formulaNode(ids[1]));
+        break;
+    case N_IMP:
+        res = std::make_shared<Imp>(formulaNode(ids[0]), formulaNode(ids[1]));
+        break;
+    case N_IFF:
+        res = std::make_shared<Iff>(formulaNode(ids[0]), formulaNode(ids[1]));
+        break;
+    case N_FORALL:
+        res = std::make_shared<Forall>(stringAt(m_data[i + 1]), formulaNode(ids[0]));
+        break;
+    case N_EXISTS:
+        res = std::make_shared<Exists>(stringAt(m_data[i + 1]), formulaNode(ids[0]));
+        break;
+    default:
+        throw "Bad file";
+    }
+
+    m_formulas[id] = res;
+    return res;
+}
+
+uint32_t BinaryReader::number()
+{
+    if (m_body + m_pos >= m_size) {
+        throw "Bad file";
+    }
+    return m_data[m_body + m_pos++];
+}
+
+std::string BinaryReader::string()
+{
+    return stringAt(number());
+}
+
+Term BinaryReader::term()
+{
+    return termNode(number());
+}
+
+Formula BinaryReader::formula()
+{
+    return formulaNode(number());
+}
+
+void BinaryReader::signature(Signature &s)
+{
+    if (number()) {
+        s.addEquality();
+    }
+    for (uint32_t n = number(); n > 0; --n) {
+        FunctionSymbol f = string();
+        s.addFunctionSymbol(f, number());
+    }
+    for (uint32_t n = number(); n > 0; --n) {
+        PredicateSymbol p = string();
+        s.addPredicateSymbol(p, number());
+    }
+}
+
+Clause BinaryReader::literals()
+{
+    Clause c(number());
+    for (Lit &l : c) {
+        l = (int32_t)number();
+    }
+    return c;
+}
+
+bool BinaryReader::atEnd() const
+{
+    return m_body + m_pos == m_size;
+}
+
+void saveFormula(const std::string &path, const Signature &s, const Formula &f)
+{
+    BinaryWriter w(SK_FORMULA);
+    w.signature(s);
+    w.formula(f);
+    w.save(path);
+}
+
+Formula loadFormula(const std::string &path, Signature &s)
+{
+    BinaryReader r(path, SK_FORMULA, s);
+    r.signature(s);
+    Formula f = r.formula();
+    if (!r.atEnd()) {
+        throw "Bad file";
+    }
+    return f;
+}
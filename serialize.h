@@ -0,0 +1,106 @@
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+#include "first_order_logic.h"
+#include "ground.h"
+
+/* Binarni zapis termova, formula, signatura i skupova osnovnih literala.
+   Datoteka se sastoji od 32-bitnih reci (u redosledu bajtova masine):
+   - zaglavlje: oznaka "GSER", verzija formata i vrsta sadrzaja,
+   - tabela niski (simboli i varijable, svaka niska samo jednom),
+   - tabela cvorova: cvor je vrsta, indeks niske, broj dece i indeksi dece,
+     pri cemu deca uvek prethode roditelju; strukturno jednaki podtermovi i
+     podformule se zapisuju samo jednom (zapis je DAG, a ne stablo),
+   - telo: niz reci koje zapisuje korisnik (brojevi, indeksi niski i
+     cvorova), redom kojim ce ih i citati.
+   Citanje ne kopira datoteku: ona se mapira u memoriju (mmap), a cvorovi
+   se pretvaraju u termove i formule tek kada se procitaju iz tela (pa se
+   signatura moze procitati pre formula koje je koriste) */
+
+const uint32_t FORMAT_VERSION = 1;
+
+/* Vrsta sadrzaja datoteke */
+enum SerializedKind { SK_FORMULA = 1, SK_CHECKPOINT = 2, SK_CERTIFICATE = 3 };
+
+class BinaryWriter {
+    uint32_t m_kind;
+    std::vector<std::string> m_strings;
+    std::map<std::string, uint32_t> m_stringIds;
+    std::vector<uint32_t> m_nodes;
+    uint32_t m_nodeCount;
+    std::map<std::vector<uint32_t>, uint32_t> m_nodeIds;
+    std::map<const void *, uint32_t> m_written;
+    std::vector<Term> m_writtenTerms;
+    std::vector<Formula> m_writtenFormulas;
+    std::vector<uint32_t> m_body;
+
+    uint32_t stringId(const std::string &str);
+    uint32_t node(const std::vector<uint32_t> &record);
+    uint32_t termNode(const Term &t);
+    uint32_t formulaNode(const Formula &f);
+
+public:
+    BinaryWriter(SerializedKind kind);
+
+    void number(uint32_t n);
+    void string(const std::string &str);
+    void term(const Term &t);
+    void formula(const Formula &f);
+    void signature(const Signature &s);
+    void literals(const Clause &c);
+
+    /* Zapisuje datoteku */
+    void save(const std::string &path) const;
+};
+
+class BinaryReader {
+    const Signature &m_signature;
+    const uint32_t *m_data;
+    size_t m_size;
+
+    std::vector<std::pair<const char *, uint32_t> > m_strings;
+    std::vector<size_t> m_nodes;
+    std::vector<Term> m_terms;
+    std::vector<Formula> m_formulas;
+    size_t m_body;
+    size_t m_pos;
+
+    uint32_t word(size_t i) const;
+    std::string stringAt(uint32_t id) const;
+    Term termNode(uint32_t id);
+    Formula formulaNode(uint32_t id);
+    void children(uint32_t id, std::vector<uint32_t> &res) const;
+
+public:
+    /* Mapira datoteku i proverava zaglavlje; termovi i formule se vezuju
+    za signaturu s */
+    BinaryReader(const std::string &path, SerializedKind kind, const Signature &s);
+    ~BinaryReader();
+
+    BinaryReader(const BinaryReader &) = delete;
+    BinaryReader &operator=(const BinaryReader &) = delete;
+
+    uint32_t number();
+    std::string string();
+    Term term();
+    Formula formula();
+
+    /* Simboli se dodaju u signaturu */
+    void signature(Signature &s);
+    Clause literals();
+
+    bool atEnd() const;
+};
+
+/* Zapisuje (pripremljenu) formulu zajedno sa njenom signaturom */
+void saveFormula(const std::string &path, const Signature &s, const Formula &f);
+
+/* Cita formulu zapisanu funkcijom saveFormula; simboli se dodaju u s */
+Formula loadFormula(const std::string &path, Signature &s);
+
+#endif
@@ -0,0 +1,491 @@
+#include "first_order_logic.h"
+#include "gilmore.h"
+#include "connection.h"
+#include "checkpoint.h"
+#include "batch.h"
+#include "ground.h"
+#include "serialize.h"
+#include "certificate.h"
+#include "compiled.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+/* Regresioni testovi: svaki test je funkcija koja vraca da li je prosao.
+   Pokretanje: make test */
+
+static Term var(const std::string &v)
+{
+    return std::make_shared<VariableTerm>(v);
+}
+
+static Term fun(Signature &s, const std::string &f, const std::vector<Term> &args = {})
+{
+    return std::make_shared<FunctionTerm>(s, f, args);
+}
+
+static Formula atom(Signature &s, const std::string &p, const std::vector<Term> &args = {})
+{
+    return std::make_shared<Atom>(s, p, args);
+}
+
+static Formula neg(const Formula &f)
+{
+    return std::make_shared<Not>(f);
+}
+
+static Formula conj(const Formula &a, const Formula &b)
+{
+    return std::make_shared<And>(a, b);
+}
+
+static Formula disj(const Formula &a, const Formula &b)
+{
+    return std::make_shared<Or>(a, b);
+}
+
+static Formula imp(const Formula &a, const Formula &b)
+{
+    return std::make_shared<Imp>(a, b);
+}
+
+static Formula forall(const std::string &v, const Formula &f)
+{
+    return std::make_shared<Forall>(v, f);
+}
+
+static Formula exists(const std::string &v, const Formula &f)
+{
+    return std::make_shared<Exists>(v, f);
+}
+
+/* Primer iz main.cpp: (H /\ K) => L, gde je p simetricna i tranzitivna */
+static Formula symmetricTransitive(Signature &s)
+{
+    s.addPredicateSymbol("p", 2);
+    Term x = var("x"), y = var("y"), z = var("z");
+
+    Formula h = forall("x", forall("y", imp(atom(s, "p", {x, y}), atom(s, "p", {y, x}))));
+    Formula k = forall("x", forall("y", forall("z",
+        imp(conj(atom(s, "p", {x, y}), atom(s, "p", {y, z})), atom(s, "p", {x, z})))));
+    Formula l = forall("x", forall("y", imp(atom(s, "p", {x, y}), atom(s, "p", {x, x}))));
+    return imp(conj(h, k), l);
+}
+
+/* Paradoks pijanca: (E x)(q(x) => (A y)q(y)) */
+static Formula drinker(Signature &s)
+{
+    s.addPredicateSymbol("q", 1);
+    return exists("x", imp(atom(s, "q", {var("x")}), forall("y", atom(s, "q", {var("y")}))));
+}
+
+/* Nije valjana: (A x)q(x) => (A x)r(x) */
+static Formula nonTheorem(Signature &s)
+{
+    s.addPredicateSymbol("q", 1);
+    s.addPredicateSymbol("r", 1);
+    return imp(forall("x", atom(s, "q", {var("x")})), forall("x", atom(s, "r", {var("x")})));
+}
+
+static ProverOptions quiet(ProverStrategy strategy = S_GILMORE)
+{
+    ProverOptions opts;
+    opts.strategy = strategy;
+    opts.verbose = false;
+    return opts;
+}
+
+/* Teoreme se dokazuju, a za formulu koja nije valjana se ne prijavljuje
+   UNSAT */
+static bool decides(ProverOptions opts)
+{
+    opts.modelSearch = true;
+
+    Signature s1, s2, s3;
+    Formula f1 = symmetricTransitive(s1), f2 = drinker(s2), f3 = nonTheorem(s3);
+    return prove(s1, f1, opts) == PR_UNSAT && prove(s2, f2, opts) == PR_UNSAT && prove(s3, f3, opts) != PR_UNSAT;
+}
+
+static bool strategies()
+{
+    for (ProverStrategy strategy : { S_GILMORE, S_RESOLUTION, S_INSTGEN, S_CONNECTION, S_PORTFOLIO }) {
+        if (!decides(quiet(strategy))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Konjunkcije se cuvaju na disku vec od prvog bajta */
+static bool outOfCore()
+{
+    ProverOptions opts = quiet();
+    opts.memoryBudget = 1;
+    return decides(opts);
+}
+
+/* Zadovoljiv skup klauza {L,K},{~L,M},{~M,~L},{~K,M}: lema dokazana pod
+   duzim putem ne sme se koristiti na kracem */
+static bool connectionLemmas()
+{
+    Signature s;
+    for (const char *p : { "L", "K", "M" }) {
+        s.addPredicateSymbol(p, 0);
+    }
+    Formula l = atom(s, "L"), k = atom(s, "K"), m = atom(s, "M");
+    Formula clauses = conj(conj(disj(l, k), disj(neg(l), m)), conj(disj(neg(m), neg(l)), disj(neg(k), m)));
+
+    return connection(s, clauses, quiet(S_CONNECTION)) != PR_UNSAT &&
+           prove(s, neg(clauses), quiet(S_PORTFOLIO)) != PR_UNSAT;
+}
+
+/* (A x)((~q(x) \/ ~p(x)) /\ q(f(x)) /\ x = f(x)) ima model sa jednim
+   elementom: uz jednakost q(x) i q(f(x)) su isti atom, pa ~q(x) nije cist
+   literal */
+static bool simplifyEquality()
+{
+    Signature s;
+    s.addEquality();
+    s.addPredicateSymbol("p", 1);
+    s.addPredicateSymbol("q", 1);
+    s.addFunctionSymbol("f", 1);
+    Term x = var("x"), fx = fun(s, "f", {x});
+    Formula f = forall("x", conj(conj(disj(neg(atom(s, "q", {x})), neg(atom(s, "p", {x}))), atom(s, "q", {fx})),
+                                 atom(s, Signature::EQUALITY, {x, fx})));
+
+    for (bool simplify : { false, true }) {
+        ProverOptions opts = quiet();
+        opts.simplifyGround = simplify;
+        opts.modelSearch = true;
+        if (gilmore(s, f, opts) != PR_SAT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string temporaryFile(const std::string &name)
+{
+    return "/tmp/gilmore-tests-" + std::to_string(getpid()) + "-" + name;
+}
+
+/* Kontrolna tacka se zapisuje posle svake instance, pa poslednja zapisana
+   tacka pobijenog nivoa ostaje usred multiplikacije; nastavak od nje mora
+   ponovo pobiti formulu */
+static bool checkpointResume()
+{
+    std::string path = temporaryFile("checkpoint");
+    ProverOptions opts = quiet();
+    opts.checkpointFile = path;
+    opts.checkpointInterval = 0;
+
+    Signature s;
+    Formula f = symmetricTransitive(s);
+    bool ok = prove(s, f, opts) == PR_UNSAT;
+
+    Signature sc;
+    Checkpoint c;
+    ok = ok && loadCheckpoint(path, sc, c) && !c.instances.empty() && c.processed > 0 && !c.level.empty();
+
+    opts.resume = true;
+    ok = ok && prove(s, f, opts) == PR_UNSAT;
+
+    /* Kontrolna tacka druge formule se zanemaruje, pa se ne vraca njen
+       rezultat */
+    Signature sr;
+    ok = ok && loadCheckpoint(path, sr, c);
+    Signature so;
+    ok = ok && prove(so, nonTheorem(so), opts) != PR_UNSAT;
+
+    std::remove(path.c_str());
+    return ok;
+}
+
+/* Simbol bez interpretacije u strukturi: izuzetak iz niti se prenosi
+   pozivaocu, kao kod sekvencijalne interpretacije */
+static bool batchErrors()
+{
+    Signature s;
+    s.addPredicateSymbol("even", 1);
+    s.addPredicateSymbol("r", 1);
+    Domain d = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    Structure st(s, d);
+    st.addRelation("even", new Even());
+
+    Formula known = forall("x", atom(s, "even", {var("x")}));
+    Formula unknown = forall("x", atom(s, "r", {var("x")}));
+
+    unsigned thrown = 0;
+    try {
+        evalBatch({ known, unknown, known, unknown }, st, 4);
+    } catch (const char *) {
+        ++thrown;
+    }
+    try {
+        evalParallel(unknown, st, 4);
+    } catch (const char *) {
+        ++thrown;
+    }
+    return thrown == 2 && !evalParallel(known, st, 4);
+}
+
+/* Sabiranje po modulu 10 nad domenom {0,1,2} izlazi iz domena, pa se
+   struktura sa njim ne tabelira: le(x, plus10(x,y)) bi inace citalo
+   pogresnu celiju tablice relacije le. Bez njega se tabelira sve, a
+   tablica sa vrednoscu (ili argumentom) van domena se odbija */
+static bool tabulateDomain()
+{
+    Signature s;
+    s.addFunctionSymbol("plus3", 2);
+    s.addFunctionSymbol("plus10", 2);
+    s.addPredicateSymbol("le", 2);
+    Domain d = { 0, 1, 2 };
+
+    Structure closed(s, d);
+    closed.addFunction("plus3", new Plus(3));
+    closed.addRelation("le", new LowerOrEqual());
+    closed.tabulate();
+    bool ok = dynamic_cast<TableFunction *>(closed.getFunction("plus3")) != nullptr &&
+              dynamic_cast<TableRelation *>(closed.getRelation("le")) != nullptr;
+
+    Structure open(s, d);
+    open.addFunction("plus3", new Plus(3));
+    open.addFunction("plus10", new Plus(10));
+    open.addRelation("le", new LowerOrEqual());
+    Formula f = forall("x", forall("y", atom(s, "le", {var("x"), fun(s, "plus10", {var("x"), var("y")})})));
+
+    Valuation v(d);
+    bool before = f->eval(open, v);
+    open.tabulate();
+    CompiledFormula c(f, open);
+    ok = ok && before && f->eval(open, v) && c.eval() &&
+         dynamic_cast<TableFunction *>(open.getFunction("plus3")) == nullptr &&
+         dynamic_cast<TableRelation *>(open.getRelation("le")) == nullptr;
+
+    unsigned rejected = 0;
+    try {
+        TableFunction t(1, 2, { 0, 5 });
+    } catch (const char *) {
+        ++rejected;
+    }
+    try {
+        TableFunction t(1, 2, { 0, 1 });
+        t.eval({ 2 });
+    } catch (const char *) {
+        ++rejected;
+    }
+    return ok && rejected == 2;
+}
+
+/* Strukturno jednaki atomi (razliciti objekti) dobijaju isti redni broj */
+static bool atomTable()
+{
+    Signature s;
+    s.addPredicateSymbol("p", 2);
+    s.addFunctionSymbol("f", 1);
+    s.addFunctionSymbol("a", 0);
+    s.addFunctionSymbol("b", 0);
+    Term a = fun(s, "a"), b = fun(s, "b");
+
+    AtomTable table;
+    unsigned p1 = table.intern(atom(s, "p", {fun(s, "f", {a}), b}));
+    unsigned p2 = table.intern(atom(s, "p", {b, fun(s, "f", {a})}));
+    unsigned p3 = table.intern(atom(s, "p", {fun(s, "f", {fun(s, "a")}), fun(s, "b")}));
+
+    unsigned id;
+    return p1 == p3 && p1 != p2 && table.size() == 2 &&
+           table.find(atom(s, "p", {b, fun(s, "f", {a})}), id) && id == p2 &&
+           !table.find(atom(s, "p", {a, a}), id);
+}
+
+/* Pojednostavljivanje osnovnih instanci ne menja ishod */
+static bool simplifyGround()
+{
+    ProverOptions opts = quiet();
+    opts.simplifyGround = true;
+    return decides(opts);
+}
+
+/* Komponente bez zajednickih atoma se pobijaju u zasebnim nitima */
+static bool splitComponents()
+{
+    ProverOptions opts = quiet();
+    opts.simplifyGround = true;
+    opts.splitComponents = true;
+    opts.perClause = true;
+    return decides(opts);
+}
+
+/* (A x)(x = a) /\ p(a) /\ ~p(b) je nezadovoljiva samo po kongruenciji */
+static Formula equalityContradiction(Signature &s)
+{
+    s.addEquality();
+    s.addPredicateSymbol("p", 1);
+    s.addFunctionSymbol("a", 0);
+    s.addFunctionSymbol("b", 0);
+    return conj(conj(forall("x", atom(s, Signature::EQUALITY, {var("x"), fun(s, "a")})), atom(s, "p", {fun(s, "a")})),
+                neg(atom(s, "p", {fun(s, "b")})));
+}
+
+/* BDD matrice, bez jednakosti i sa njom */
+static bool bdd()
+{
+    ProverOptions opts = quiet();
+    opts.bdd = true;
+
+    Signature s;
+    Formula f = equalityContradiction(s);
+    return decides(opts) && gilmore(s, f, opts) == PR_UNSAT;
+}
+
+/* Familija konjunkcija kao ZDD, bez jednakosti i sa njom */
+static bool zdd()
+{
+    ProverOptions opts = quiet();
+    opts.zdd = true;
+
+    Signature s;
+    Formula f = equalityContradiction(s);
+    return decides(opts) && gilmore(s, f, opts) == PR_UNSAT;
+}
+
+/* Zapisana pa procitana formula je jednaka polaznoj, a simboli su
+   dodati u novu signaturu; datoteka druge vrste se ne prihvata */
+static bool formulaRoundTrip()
+{
+    std::string path = temporaryFile("formula");
+    Signature s;
+    Formula f = skolemMatrix(s, neg(symmetricTransitive(s)), quiet());
+    saveFormula(path, s, f);
+
+    Signature loaded;
+    Formula g = loadFormula(path, loaded);
+    bool ok = g->equalTo(f) && loaded.getPredicateSymbols() == s.getPredicateSymbols() &&
+              loaded.getFunctionSymbols() == s.getFunctionSymbols();
+
+    Checkpoint c;
+    try {
+        loadCheckpoint(path, loaded, c);
+        ok = false;
+    } catch (const char *) {
+    }
+
+    std::remove(path.c_str());
+    return ok;
+}
+
+/* Poziva program checker (make test ga prevodi pre testova) */
+static bool checkerAccepts(const std::string &path, const std::string &conjecture = "")
+{
+    return std::system(("./checker " + path + " " + conjecture + " > /dev/null").c_str()) == 0;
+}
+
+/* Sertifikat dokaza prihvata nezavisni program checker, a sertifikat sa
+   izmenjenim tabloom, instancom ili matricom, kao i sertifikat za drugu
+   teoremu, odbija */
+static bool certificateChecker()
+{
+    std::string path = temporaryFile("certificate");
+    std::string tampered = temporaryFile("tampered");
+    std::string conjecture = temporaryFile("conjecture");
+    std::string other = temporaryFile("other");
+    bool ok = true;
+
+    Signature sf;
+    saveFormula(conjecture, sf, symmetricTransitive(sf));
+    Signature so;
+    saveFormula(other, so, drinker(so));
+
+    for (bool perClause : { false, true }) {
+        ProverOptions opts = quiet();
+        opts.perClause = perClause;
+        opts.certificateFile = path;
+
+        Signature s;
+        ok = ok && prove(s, symmetricTransitive(s), opts) == PR_UNSAT && checkerAccepts(path);
+        ok = ok && checkerAccepts(path, conjecture) && !checkerAccepts(path, other);
+
+        Signature sc;
+        Certificate c;
+        loadCertificate(path, sc, c);
+
+        Certificate bad = c;
+        bad.tableau.back() += 1000;
+        saveCertificate(tampered, sc, bad);
+        ok = ok && !checkerAccepts(tampered);
+
+        bad = c;
+        bad.instances[0] = neg(bad.instances[0]);
+        saveCertificate(tampered, sc, bad);
+        ok = ok && !checkerAccepts(tampered);
+
+        /* Matrica sastavljena od samih instanci: instance i tablo su
+           ispravni, ali matrica nije izvedena iz formule */
+        bad = c;
+        bad.matrix = Formula();
+        for (size_t i = 0; i < bad.instances.size(); ++i) {
+            bad.matrix = bad.matrix ? conj(bad.matrix, bad.instances[i]) : bad.instances[i];
+            bad.conjuncts[i] = i;
+        }
+        saveCertificate(tampered, sc, bad);
+        ok = ok && !checkerAccepts(tampered);
+
+        /* Matrica sa dodatnim konjunktom */
+        bad = c;
+        sc.addPredicateSymbol("r", 2);
+        bad.matrix = conj(bad.matrix, atom(sc, "r", { var("x"), var("x") }));
+        saveCertificate(tampered, sc, bad);
+        ok = ok && !checkerAccepts(tampered);
+    }
+
+    std::remove(path.c_str());
+    std::remove(tampered.c_str());
+    std::remove(conjecture.c_str());
+    std::remove(other.c_str());
+    return ok;
+}
+
+struct TestCase {
+    const char *name;
+    bool (*run)();
+};
+
+int main()
+{
+    std::vector<TestCase> tests = {
+        { "strategies", strategies },
+        { "connection lemmas", connectionLemmas },
+        { "simplifyGround with equality", simplifyEquality },
+        { "simplifyGround", simplifyGround },
+        { "splitComponents", splitComponents },
+        { "bdd", bdd },
+        { "zdd", zdd },
+        { "checkpoint resume", checkpointResume },
+        { "formula round trip", formulaRoundTrip },
+        { "certificate checker", certificateChecker },
+        { "out-of-core conjuncts", outOfCore },
+        { "batch evaluation errors", batchErrors },
+        { "tabulate outside domain", tabulateDomain },
+        { "atom table", atomTable },
+    };
+
+    unsigned failed = 0;
+    for (const TestCase &t : tests) {
+        bool ok = false;
+        try {
+            ok = t.run();
+        } catch (const char *msg) {
+            std::cout << t.name << ": " << msg << std::endl;
+        }
+        std::cout << (ok ? "PASS " : "FAIL ") << t.name << std::endl;
+        failed += !ok;
+    }
+
+    std::cout << tests.size() - failed << "/" << tests.size() << " passed" << std::endl;
+    return failed ? 1 : 0;
+}
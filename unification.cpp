@@ -0,0 +1,481 @@
+#include "unification.h"
+
+#include <utility>
+
+Term walk(const Term &t, const Substitution &s)
+{
+    Term res = t;
+    while (res->getType() == BaseTerm::TT_VARIABLE) {
+        auto it = s.find(((VariableTerm*)res.get())->getVariable());
+        if (it == s.end()) {
+            break;
+        }
+        res = it->second;
+    }
+    return res;
+}
+
+bool occurs(const Variable &v, const Term &t, const Substitution &s)
+{
+    Term w = walk(t, s);
+    if (w->getType() == BaseTerm::TT_VARIABLE) {
+        return ((VariableTerm*)w.get())->getVariable() == v;
+    }
+
+    for (const Term &op : ((FunctionTerm*)w.get())->getOperands()) {
+        if (occurs(v, op, s)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Unifikacija parova termova sa steka. Vezane varijable se pamte u tragu,
+   kako bi se u slucaju neuspeha supstitucija vratila u polazno stanje */
+static bool unifyPairs(std::vector< std::pair<Term, Term> > &stack, Substitution &s)
+{
+    std::vector<Variable> trail;
+    bool ok = true;
+
+    while (ok && !stack.empty()) {
+        Term t1 = walk(stack.back().first, s);
+        Term t2 = walk(stack.back().second, s);
+        stack.pop_back();
+
+        if (t1 == t2) {
+            continue;
+        }
+
+        if (t1->getType() == BaseTerm::TT_FUNCTION && t2->getType() == BaseTerm::TT_VARIABLE) {
+            std::swap(t1, t2);
+        }
+
+        if (t1->getType() == BaseTerm::TT_VARIABLE) {
+            const Variable &v = ((VariableTerm*)t1.get())->getVariable();
+            if (t2->getType() == BaseTerm::TT_VARIABLE &&
+                    ((VariableTerm*)t2.get())->getVariable() == v) {
+                continue;
+            }
+            if (occurs(v, t2, s)) {
+                ok = false;
+                break;
+            }
+            s.insert(std::make_pair(v, t2));
+            trail.push_back(v);
+            continue;
+        }
+
+        FunctionTerm *f1 = (FunctionTerm*)t1.get();
+        FunctionTerm *f2 = (FunctionTerm*)t2.get();
+        if (f1->getSymbol() != f2->getSymbol() ||
+                f1->getOperands().size() != f2->getOperands().size()) {
+            ok = false;
+            break;
+        }
+        for (size_t i = 0; i < f1->getOperands().size(); ++i) {
+            stack.push_back(std::make_pair(f1->getOperands()[i], f2->getOperands()[i]));
+        }
+    }
+
+    if (ok) {
+        return true;
+    }
+
+    for (const Variable &v : trail) {
+        s.erase(v);
+    }
+    return false;
+}
+
+/* Parovi operanada dva literala istog znaka i predikatskog simbola */
+static bool literalPairs(const Formula &l1, const Formula &l2,
+                         std::vector< std::pair<Term, Term> > &pairs)
+{
+    Formula a1 = l1;
+    Formula a2 = l2;
+    if (a1->getType() == BaseFormula::T_NOT && a2->getType() == BaseFormula::T_NOT) {
+        a1 = ((Not*)a1.get())->getOperand();
+        a2 = ((Not*)a2.get())->getOperand();
+    }
+
+    if (a1->getType() != BaseFormula::T_ATOM || a2->getType() != BaseFormula::T_ATOM) {
+        return false;
+    }
+
+    Atom *p1 = (Atom*)a1.get();
+    Atom *p2 = (Atom*)a2.get();
+    if (p1->getSymbol() != p2->getSymbol() ||
+            p1->getOperands().size() != p2->getOperands().size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < p1->getOperands().size(); ++i) {
+        pairs.push_back(std::make_pair(p1->getOperands()[i], p2->getOperands()[i]));
+    }
+    return true;
+}
+
+bool unify(const Term &t1, const Term &t2, Substitution &s)
+{
+    std::vector< std::pair<Term, Term> > stack{ std::make_pair(t1, t2) };
+    return unifyPairs(stack, s);
+}
+
+bool unify(const Formula &l1, const Formula &l2, Substitution &s)
+{
+    std::vector< std::pair<Term, Term> > stack;
+    if (!literalPairs(l1, l2, stack)) {
+        return false;
+    }
+    return unifyPairs(stack, s);
+}
+
+/* Matching parova (obrazac, term). Vezivanja se ne prate kroz term, vec
+   se vezana varijabla obrasca poredi sa termom sintaksno */
+static bool matchPairs(std::vector< std::pair<Term, Term> > &stack, Substitution &s)
+{
+    std::vector<Variable> trail;
+    bool ok = true;
+
+    while (ok && !stack.empty()) {
+        Term p = stack.back().first;
+        Term t = stack.back().second;
+        stack.pop_back();
+
+        if (p->getType() == BaseTerm::TT_VARIABLE) {
+            const Variable &v = ((VariableTerm*)p.get())->getVariable();
+            auto it = s.find(v);
+            if (it == s.end()) {
+                s.insert(std::make_pair(v, t));
+                trail.push_back(v);
+            } else if (!it->second->equalTo(t)) {
+                ok = false;
+            }
+            continue;
+        }
+
+        if (t->getType() != BaseTerm::TT_FUNCTION) {
+            ok = false;
+            break;
+        }
+
+        FunctionTerm *f1 = (FunctionTerm*)p.get();
+        FunctionTerm *f2 = (FunctionTerm*)t.get();
+        if (f1->getSymbol() != f2->getSymbol() ||
+                f1->getOperands().size() != f2->getOperands().size()) {
+            ok = false;
+            break;
+        }
+        for (size_t i = 0; i < f1->getOperands().size(); ++i) {
+            stack.push_back(std::make_pair(f1->getOperands()[i], f2->getOperands()[i]));
+        }
+    }
+
+    if (ok) {
+        return true;
+    }
+
+    for (const Variable &v : trail) {
+        s.erase(v);
+    }
+    return false;
+}
+
+bool match(const Term &pattern, const Term &t, Substitution &s)
+{
+    std::vector< std::pair<Term, Term> > stack{ std::make_pair(pattern, t) };
+    return matchPairs(stack, s);
+}
+
+bool match(const Formula &pattern, const Formula &l, Substitution &s)
+{
+    std::vector< std::pair<Term, Term> > stack;
+    if (!literalPairs(pattern, l, stack)) {
+        return false;
+    }
+    return matchPairs(stack, s);
+}
+
+Term applySubstitution(const Term &t, const Substitution &s)
+{
+    Term w = walk(t, s);
+    if (w->getType() == BaseTerm::TT_VARIABLE) {
+        return w;
+    }
+
+    FunctionTerm *ft = (FunctionTerm*)w.get();
+    std::vector<Term> ops;
+    bool changed = false;
+    for (const Term &op : ft->getOperands()) {
+        ops.push_back(applySubstitution(op, s));
+        changed = changed || ops.back() != op;
+    }
+
+    if (!changed) {
+        return w;
+    }
+    return std::make_shared<FunctionTerm>(ft->getSignature(), ft->getSymbol(), std::move(ops));
+}
+
+Formula applySubstitution(const Formula &l, const Substitution &s)
+{
+    switch (l->getType()) {
+    case BaseFormula::T_TRUE:
+    case BaseFormula::T_FALSE:
+        return l;
+    case BaseFormula::T_NOT: {
+        Formula op = ((Not*)l.get())->getOperand();
+        Formula res = applySubstitution(op, s);
+        return res == op ? l : std::make_shared<Not>(res);
+    }
+    case BaseFormula::T_ATOM: {
+        Atom *a = (Atom*)l.get();
+        std::vector<Term> ops;
+        bool changed = false;
+        for (const Term &op : a->getOperands()) {
+            ops.push_back(applySubstitution(op, s));
+            changed = changed || ops.back() != op;
+        }
+        if (!changed) {
+            return l;
+        }
+        return std::make_shared<Atom>(a->getSignature(), a->getSymbol(), std::move(ops));
+    }
+    default:
+        throw "Substitution not applicable";
+    }
+}
+
+static void orderedVars(const Term &t, std::vector<Variable> &vars)
+{
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        const Variable &v = ((VariableTerm*)t.get())->getVariable();
+        if (std::find(vars.begin(), vars.end(), v) == vars.end()) {
+            vars.push_back(v);
+        }
+        return;
+    }
+    for (const Term &op : ((FunctionTerm*)t.get())->getOperands()) {
+        orderedVars(op, vars);
+    }
+}
+
+/* Istovremeno preimenovanje varijabli (za razliku od applySubstitution,
+   bez pracenja lanca vezivanja) */
+static Term renameTerm(const Term &t, const std::map<Variable, Term> &names)
+{
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        auto it = names.find(((VariableTerm*)t.get())->getVariable());
+        return it == names.end() ? t : it->second;
+    }
+
+    FunctionTerm *ft = (FunctionTerm*)t.get();
+    if (ft->getOperands().empty()) {
+        return t;
+    }
+    std::vector<Term> ops;
+    for (const Term &op : ft->getOperands()) {
+        ops.push_back(renameTerm(op, names));
+    }
+    return std::make_shared<FunctionTerm>(ft->getSignature(), ft->getSymbol(), std::move(ops));
+}
+
+static Formula renameLiteral(const Formula &l, const std::map<Variable, Term> &names)
+{
+    if (l->getType() == BaseFormula::T_NOT) {
+        return std::make_shared<Not>(renameLiteral(((Not*)l.get())->getOperand(), names));
+    }
+
+    Atom *a = (Atom*)l.get();
+    std::vector<Term> ops;
+    for (const Term &op : a->getOperands()) {
+        ops.push_back(renameTerm(op, names));
+    }
+    return std::make_shared<Atom>(a->getSignature(), a->getSymbol(), std::move(ops));
+}
+
+LiteralList renameClause(const LiteralList &literals, const std::string &prefix)
+{
+    std::vector<Variable> vars;
+    for (const Formula &l : literals) {
+        Formula atom = l->getType() == BaseFormula::T_NOT ? ((Not*)l.get())->getOperand() : l;
+        for (const Term &op : ((Atom*)atom.get())->getOperands()) {
+            orderedVars(op, vars);
+        }
+    }
+
+    std::map<Variable, Term> names;
+    for (size_t i = 0; i < vars.size(); ++i) {
+        names[vars[i]] = std::make_shared<VariableTerm>(prefix + std::to_string(i));
+    }
+
+    LiteralList res;
+    for (const Formula &l : literals) {
+        res.push_back(renameLiteral(l, names));
+    }
+    return res;
+}
+
+
+DiscriminationTree::DiscriminationTree()
+{
+    m_nodes.push_back(Node());
+    m_nodes[0].arity = 0;
+}
+
+void DiscriminationTree::flattenTerm(const Term &t, std::vector<Token> &tokens)
+{
+    if (t->getType() == BaseTerm::TT_VARIABLE) {
+        tokens.push_back(Token{ "*", 0, true });
+        return;
+    }
+
+    FunctionTerm *ft = (FunctionTerm*)t.get();
+    unsigned arity = ft->getOperands().size();
+    tokens.push_back(Token{ ft->getSymbol() + "/" + std::to_string(arity), arity, false });
+    for (const Term &op : ft->getOperands()) {
+        flattenTerm(op, tokens);
+    }
+}
+
+std::vector<DiscriminationTree::Token> DiscriminationTree::flatten(const Formula &literal)
+{
+    std::string sign;
+    Formula atom = literal;
+    if (atom->getType() == BaseFormula::T_NOT) {
+        sign = "~";
+        atom = ((Not*)atom.get())->getOperand();
+    }
+    if (atom->getType() != BaseFormula::T_ATOM) {
+        throw "Bad type";
+    }
+
+    Atom *a = (Atom*)atom.get();
+    unsigned arity = a->getOperands().size();
+    std::vector<Token> tokens{ Token{ sign + a->getSymbol() + "/" + std::to_string(arity), arity, false } };
+    for (const Term &op : a->getOperands()) {
+        flattenTerm(op, tokens);
+    }
+    return tokens;
+}
+
+void DiscriminationTree::insert(const Formula &literal, unsigned id)
+{
+    unsigned node = 0;
+    for (const Token &token : flatten(literal)) {
+        auto it = m_nodes[node].children.find(token.key);
+        if (it != m_nodes[node].children.end()) {
+            node = it->second;
+            continue;
+        }
+
+        unsigned child = m_nodes.size();
+        m_nodes.push_back(Node());
+        m_nodes[child].arity = token.arity;
+        m_nodes[node].children.insert(std::make_pair(token.key, child));
+        node = child;
+    }
+    m_nodes[node].entries.push_back(id);
+}
+
+void DiscriminationTree::remove(const Formula &literal, unsigned id)
+{
+    unsigned node = 0;
+    for (const Token &token : flatten(literal)) {
+        auto it = m_nodes[node].children.find(token.key);
+        if (it == m_nodes[node].children.end()) {
+            return;
+        }
+        node = it->second;
+    }
+
+    std::vector<unsigned> &entries = m_nodes[node].entries;
+    auto it = std::find(entries.begin(), entries.end(), id);
+    if (it != entries.end()) {
+        entries.erase(it);
+    }
+}
+
+/* Preskace jedan podterm u stablu (remaining je broj podtermova koje jos
+   treba preskociti) i vraca sve cvorove u kojima se preskakanje zavrsava */
+void DiscriminationTree::skipSubterm(unsigned node, unsigned remaining, std::vector<unsigned> &ends) const
+{
+    if (remaining == 0) {
+        ends.push_back(node);
+        return;
+    }
+
+    for (const auto &child : m_nodes[node].children) {
+        skipSubterm(child.second, remaining - 1 + m_nodes[child.second].arity, ends);
+    }
+}
+
+void DiscriminationTree::collect(unsigned node, const std::vector<Token> &query, const std::vector<size_t> &next,
+                                 size_t pos, Mode mode, std::vector<unsigned> &result) const
+{
+    if (pos == query.size()) {
+        result.insert(result.end(), m_nodes[node].entries.begin(), m_nodes[node].entries.end());
+        return;
+    }
+
+    const Node &n = m_nodes[node];
+    const Token &token = query[pos];
+
+    if (token.variable && mode != M_GENERALIZATIONS) {
+        /* Varijabla upita pokriva ceo podterm u stablu */
+        std::vector<unsigned> ends;
+        skipSubterm(node, 1, ends);
+        for (unsigned end : ends) {
+            collect(end, query, next, pos + 1, mode, result);
+        }
+        return;
+    }
+
+    auto it = n.children.find(token.key);
+    if (it != n.children.end()) {
+        collect(it->second, query, next, pos + 1, mode, result);
+    }
+
+    /* Varijabla u stablu pokriva ceo podterm upita */
+    if (!token.variable && mode != M_INSTANCES) {
+        auto var = n.children.find("*");
+        if (var != n.children.end()) {
+            collect(var->second, query, next, next[pos], mode, result);
+        }
+    }
+}
+
+std::vector<unsigned> DiscriminationTree::retrieve(const Formula &literal, Mode mode) const
+{
+    std::vector<Token> query = flatten(literal);
+
+    /* next[i] je pozicija prvog simbola iza podterma koji pocinje na
+       poziciji i */
+    std::vector<size_t> next(query.size());
+    for (size_t i = query.size(); i-- > 0; ) {
+        size_t j = i + 1;
+        for (unsigned k = 0; k < query[i].arity; ++k) {
+            j = next[j];
+        }
+        next[i] = j;
+    }
+
+    std::vector<unsigned> result;
+    collect(0, query, next, 0, mode, result);
+    return result;
+}
+
+std::vector<unsigned> DiscriminationTree::unifiable(const Formula &literal) const
+{
+    return retrieve(literal, M_UNIFIABLE);
+}
+
+std::vector<unsigned> DiscriminationTree::generalizations(const Formula &literal) const
+{
+    return retrieve(literal, M_GENERALIZATIONS);
+}
+
+std::vector<unsigned> DiscriminationTree::instances(const Formula &literal) const
+{
+    return retrieve(literal, M_INSTANCES);
+}
@@ -0,0 +1,100 @@
+#ifndef UNIFICATION_H
+#define UNIFICATION_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "first_order_logic.h"
+
+/* Supstitucija u trougaonom obliku: varijabla se preslikava u term koji i
+   sam moze sadrzati vezane varijable, pa se vrednost varijable dobija
+   pracenjem lanca vezivanja (funkcija walk) */
+typedef std::map<Variable, Term> Substitution;
+
+/* Prati lanac vezivanja dok se ne dodje do funkcijskog terma ili slobodne
+   varijable */
+Term walk(const Term &t, const Substitution &s);
+
+/* Provera pojavljivanja (occurs check): da li se varijabla v javlja u termu
+   t pod supstitucijom s */
+bool occurs(const Variable &v, const Term &t, const Substitution &s);
+
+/* Prosiruje supstituciju s najopstijim unifikatorom termova t1 i t2. Ako
+   unifikacija ne uspe, vraca false i ostavlja s nepromenjenu */
+bool unify(const Term &t1, const Term &t2, Substitution &s);
+
+/* Unifikacija literala (atoma ili negacija atoma) istog znaka */
+bool unify(const Formula &l1, const Formula &l2, Substitution &s);
+
+/* Jednosmerna unifikacija (matching): prosiruje s tako da instanca
+   obrasca pattern bude jednaka termu t. Varijable terma t se ne vezuju.
+   Ako ne uspe, vraca false i ostavlja s nepromenjenu */
+bool match(const Term &pattern, const Term &t, Substitution &s);
+
+/* Matching literala istog znaka */
+bool match(const Formula &pattern, const Formula &l, Substitution &s);
+
+/* Primena supstitucije na term */
+Term applySubstitution(const Term &t, const Substitution &s);
+
+/* Primena supstitucije na literal (atom ili negaciju atoma) */
+Formula applySubstitution(const Formula &l, const Substitution &s);
+
+/* Preimenuje varijable klauze u prefix0, prefix1, ... redom pojavljivanja
+   (standardizacija klauze, pa su varijante iste klauze sintaksno jednake) */
+LiteralList renameClause(const LiteralList &literals, const std::string &prefix);
+
+
+/* Diskriminaciono stablo literala. Literal se zapisuje kao niz simbola u
+   prefiksnom obilasku (predikat sa znakom, pa funkcijski simboli), pri cemu
+   se sve varijable zapisuju istim simbolom '*'. Pretraga vraca kandidate
+   (redne brojeve pridruzene literalima) koji su unifikabilni sa upitom,
+   koji su uopstenja upita ili koji su instance upita. Kako se varijable ne
+   razlikuju, kandidati za upite sa ponovljenim varijablama se moraju
+   naknadno proveriti funkcijama unify i match */
+class DiscriminationTree {
+    struct Node {
+        std::map<std::string, unsigned> children;
+        unsigned arity;
+        std::vector<unsigned> entries;
+    };
+
+    struct Token {
+        std::string key;
+        unsigned arity;
+        bool variable;
+    };
+
+    enum Mode { M_UNIFIABLE, M_GENERALIZATIONS, M_INSTANCES };
+
+    std::vector<Node> m_nodes;
+
+    static void flattenTerm(const Term &t, std::vector<Token> &tokens);
+    static std::vector<Token> flatten(const Formula &literal);
+
+    void skipSubterm(unsigned node, unsigned remaining, std::vector<unsigned> &ends) const;
+    void collect(unsigned node, const std::vector<Token> &query, const std::vector<size_t> &next,
+                 size_t pos, Mode mode, std::vector<unsigned> &result) const;
+    std::vector<unsigned> retrieve(const Formula &literal, Mode mode) const;
+
+public:
+    DiscriminationTree();
+
+    /* Dodaje literal sa pridruzenim rednim brojem id */
+    void insert(const Formula &literal, unsigned id);
+
+    /* Uklanja literal sa pridruzenim rednim brojem id */
+    void remove(const Formula &literal, unsigned id);
+
+    /* Kandidati koji se mogu unifikovati sa literalom */
+    std::vector<unsigned> unifiable(const Formula &literal) const;
+
+    /* Kandidati ciji je literal uopstenje datog literala */
+    std::vector<unsigned> generalizations(const Formula &literal) const;
+
+    /* Kandidati ciji je literal instanca datog literala */
+    std::vector<unsigned> instances(const Formula &literal) const;
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include "zdd.h"
+
+#include <climits>
+#include <algorithm>
+#include <cstdlib>
+
+static uint64_t pairKey(Zdd f, Zdd g)
+{
+    return (uint64_t)f << 32 | g;
+}
+
+ZddManager::ZddManager()
+{
+    /* Listovi imaju varijablu iza svih ostalih */
+    m_nodes.push_back(Node{ UINT_MAX, ZDD_EMPTY, ZDD_EMPTY });
+    m_nodes.push_back(Node{ UINT_MAX, ZDD_BASE, ZDD_BASE });
+}
+
+unsigned ZddManager::var(Zdd f) const
+{
+    return m_nodes[f].var;
+}
+
+Zdd ZddManager::node(unsigned var, Zdd low, Zdd high)
+{
+    if (high == ZDD_EMPTY) {
+        return low;
+    }
+
+    Node n{ var, low, high };
+    auto it = m_unique.find(n);
+    if (it != m_unique.end()) {
+        return it->second;
+    }
+
+    Zdd f = m_nodes.size();
+    m_nodes.push_back(n);
+    m_unique.insert(std::make_pair(n, f));
+    return f;
+}
+
+Zdd ZddManager::literal(Lit l)
+{
+    unsigned v = 2 * (std::abs(l) - 1) + (l < 0);
+    return node(v, ZDD_EMPTY, ZDD_BASE);
+}
+
+Zdd ZddManager::unite(Zdd f, Zdd g)
+{
+    if (f == ZDD_EMPTY || f == g) {
+        return g;
+    }
+    if (g == ZDD_EMPTY) {
+        return f;
+    }
+
+    if (f > g) {
+        std::swap(f, g);
+    }
+    uint64_t key = pairKey(f, g);
+    auto it = m_unions.find(key);
+    if (it != m_unions.end()) {
+        return it->second;
+    }
+
+    Zdd res;
+    if (var(f) < var(g)) {
+        res = node(var(f), unite(m_nodes[f].low, g), m_nodes[f].high);
+    } else if (var(g) < var(f)) {
+        res = node(var(g), unite(f, m_nodes[g].low), m_nodes[g].high);
+    } else {
+        res = node(var(f), unite(m_nodes[f].low, m_nodes[g].low), unite(m_nodes[f].high, m_nodes[g].high));
+    }
+
+    m_unions.insert(std::make_pair(key, res));
+    return res;
+}
+
+Zdd ZddManager::product(Zdd f, Zdd g)
+{
+    if (f == ZDD_EMPTY || g == ZDD_EMPTY) {
+        return ZDD_EMPTY;
+    }
+    if (f == ZDD_BASE) {
+        return g;
+    }
+    if (g == ZDD_BASE) {
+        return f;
+    }
+
+    if (f > g) {
+        std::swap(f, g);
+    }
+    uint64_t key = pairKey(f, g);
+    auto it = m_products.find(key);
+    if (it != m_products.end()) {
+        return it->second;
+    }
+
+    /* Kofaktori po najmanjoj varijabli v: skupovi bez v i skupovi sa v
+    (bez samog v) */
+    unsigned v = std::min(var(f), var(g));
+    Zdd f0 = var(f) == v ? m_nodes[f].low : f;
+    Zdd f1 = var(f) == v ? m_nodes[f].high : ZDD_EMPTY;
+    Zdd g0 = var(g) == v ? m_nodes[g].low : g;
+    Zdd g1 = var(g) == v ? m_nodes[g].high : ZDD_EMPTY;
+
+    Zdd high = unite(product(f1, g1), unite(product(f1, g0), product(f0, g1)));
+    Zdd res = node(v, product(f0, g0), high);
+
+    m_products.insert(std::make_pair(key, res));
+    return res;
+}
+
+/* Skupovi familije koji ne sadrze varijablu v */
+Zdd ZddManager::subset0(Zdd f, unsigned v)
+{
+    if (var(f) > v) {
+        return f;
+    }
+    if (var(f) == v) {
+        return m_nodes[f].low;
+    }
+
+    uint64_t key = pairKey(f, v);
+    auto it = m_subsets.find(key);
+    if (it != m_subsets.end()) {
+        return it->second;
+    }
+
+    Zdd res = node(var(f), subset0(m_nodes[f].low, v), subset0(m_nodes[f].high, v));
+    m_subsets.insert(std::make_pair(key, res));
+    return res;
+}
+
+Zdd ZddManager::removeComplementary(Zdd f)
+{
+    if (f == ZDD_EMPTY || f == ZDD_BASE) {
+        return f;
+    }
+
+    auto it = m_filtered.find(f);
+    if (it != m_filtered.end()) {
+        return it->second;
+    }
+
+    /* Skupovi sa pozitivnim literalom ne smeju sadrzati negativni, koji je
+    sledeca varijabla */
+    unsigned v = var(f);
+    Zdd high = m_nodes[f].high;
+    if (v % 2 == 0) {
+        high = subset0(high, v + 1);
+    }
+    Zdd res = node(v, removeComplementary(m_nodes[f].low), removeComplementary(high));
+
+    m_filtered.insert(std::make_pair(f, res));
+    return res;
+}
+
+void ZddManager::sets(Zdd f, Clause &set, std::vector<Clause> &res) const
+{
+    if (f == ZDD_EMPTY) {
+        return;
+    }
+    if (f == ZDD_BASE) {
+        res.push_back(set);
+        return;
+    }
+
+    unsigned v = var(f);
+    sets(m_nodes[f].low, set, res);
+    set.push_back(v % 2 ? -(Lit)(v / 2 + 1) : (Lit)(v / 2 + 1));
+    sets(m_nodes[f].high, set, res);
+    set.pop_back();
+}
+
+std::vector<Clause> ZddManager::sets(Zdd f) const
+{
+    std::vector<Clause> res;
+    Clause set;
+    sets(f, set, res);
+    return res;
+}
+
+size_t ZddManager::size() const
+{
+    return m_nodes.size();
+}
+
+Zdd formulaToZdd(const Formula &f, AtomTable &table, ZddManager &manager)
+{
+    switch (f->getType()) {
+    case BaseFormula::T_TRUE:
+        return ZDD_BASE;
+    case BaseFormula::T_FALSE:
+        return ZDD_EMPTY;
+    case BaseFormula::T_ATOM:
+    case BaseFormula::T_NOT:
+        return manager.literal(encodeLiteral(f, table));
+    case BaseFormula::T_AND:
+        return manager.product(formulaToZdd(((And*)f.get())->getOperand1(), table, manager),
+                               formulaToZdd(((And*)f.get())->getOperand2(), table, manager));
+    case BaseFormula::T_OR:
+        return manager.unite(formulaToZdd(((Or*)f.get())->getOperand1(), table, manager),
+                             formulaToZdd(((Or*)f.get())->getOperand2(), table, manager));
+    default:
+        throw "Bad type";
+    }
+}
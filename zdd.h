@@ -0,0 +1,73 @@
+#ifndef ZDD_H
+#define ZDD_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "ground.h"
+
+/* Cvor ZDD-a; 0 je prazna familija, a 1 familija koja sadrzi samo prazan
+   skup */
+typedef unsigned Zdd;
+
+const Zdd ZDD_EMPTY = 0;
+const Zdd ZDD_BASE = 1;
+
+/* Familije skupova literala kao ZDD-ovi (zero-suppressed decision
+   diagrams): cvor cija visoka grana vodi u praznu familiju se izostavlja,
+   pa se literal koji se u skupu ne javlja ne predstavlja. Familija
+   konjunkcija DNF-a se tako gradi i filtrira nad deljenom strukturom, bez
+   nabrajanja konjunkcija. Literal atoma sa rednim brojem i je varijabla
+   2i (pozitivan) odnosno 2i + 1 (negativan), pa su komplementarni
+   literali susedni u redosledu varijabli */
+class ZddManager {
+    struct Node {
+        unsigned var;
+        Zdd low;
+        Zdd high;
+
+        bool operator==(const Node &n) const { return var == n.var && low == n.low && high == n.high; }
+    };
+    struct NodeHash {
+        size_t operator()(const Node &n) const { return ((size_t)n.var * 1000003 + n.low) * 1000003 + n.high; }
+    };
+    std::vector<Node> m_nodes;
+    std::unordered_map<Node, Zdd, NodeHash> m_unique;
+    std::unordered_map<uint64_t, Zdd> m_unions;
+    std::unordered_map<uint64_t, Zdd> m_products;
+    std::unordered_map<uint64_t, Zdd> m_subsets;
+    std::unordered_map<Zdd, Zdd> m_filtered;
+
+    unsigned var(Zdd f) const;
+    Zdd node(unsigned var, Zdd low, Zdd high);
+    Zdd subset0(Zdd f, unsigned var);
+    void sets(Zdd f, Clause &set, std::vector<Clause> &res) const;
+
+public:
+    ZddManager();
+
+    /* Familija sa jednim jednoclanim skupom {l} */
+    Zdd literal(Lit l);
+
+    /* Unija familija */
+    Zdd unite(Zdd f, Zdd g);
+
+    /* Proizvod familija: sve unije po jednog skupa iz svake */
+    Zdd product(Zdd f, Zdd g);
+
+    /* Familija bez skupova koji sadrze komplementaran par literala */
+    Zdd removeComplementary(Zdd f);
+
+    /* Skupovi familije, kao liste literala */
+    std::vector<Clause> sets(Zdd f) const;
+
+    /* Broj cvorova u tabeli */
+    size_t size() const;
+};
+
+/* Familija konjunkcija DNF-a osnovne formule u NNF-u (proizvod za
+   konjunkciju, unija za disjunkciju, kao u listDNF) */
+Zdd formulaToZdd(const Formula &f, AtomTable &table, ZddManager &manager);
+
+#endif